@@ -1,21 +1,83 @@
 ﻿#include "BookKeeper/HSClassTranslator.h"
 
+#include "Core/HScaleDevSettings.h"
 #include "Utils/HScaleConversionUtils.h"
+#include "Misc/PackageName.h"
+
+void FHSClassTranslator::WarmUpClassCache()
+{
+	for (const FSoftClassPath& ClassPath : UHScaleDevSettings::GetPreloadClasses())
+	{
+		RegisterClassPath(ClassPath);
+	}
+
+	for (const FHScale_ReplicationClassOptions& Options : UHScaleDevSettings::GetClassesReplicationOptions())
+	{
+		RegisterClassPath(FSoftClassPath(Options.ActorClass.ToString()));
+	}
+
+	UE_LOG(Log_HyperScaleGlobals, Log, TEXT("Class cache warmed up with %d classes, %d packages loading"), ClassIdPathCache.Num(), PendingPackages.Num())
+}
+
+uint64 FHSClassTranslator::RegisterClassPath(const FSoftClassPath& ClassPath)
+{
+	if (ClassPath.IsNull()) return 0;
+
+	const FString ClassPathString = ClassPath.ToString();
+	const uint64 ClassId = FHScaleConversionUtils::HashFString(ClassPathString);
+	ClassIdPathCache.Add(ClassId, ClassPathString);
+
+	if (UClass* Class = ClassPath.ResolveClass())
+	{
+		ClassIdPtrCache.Add(ClassId, Class);
+	}
+	else
+	{
+		RequestPackageAsync(ClassPath.GetLongPackageName());
+	}
+	return ClassId;
+}
+
+bool FHSClassTranslator::RequestPackageAsync(const FString& PackageName)
+{
+	if (PendingPackages.Contains(PackageName)) return true;
+	if (FailedPackages.Contains(PackageName)) return false;
+	if (!FPackageName::IsValidLongPackageName(PackageName)) return false;
+	if (FindPackage(nullptr, *PackageName)) return false;
+
+	PendingPackages.Add(PackageName);
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda([this](const FName& LoadedName, UPackage* Package, EAsyncLoadingResult::Type Result)
+	{
+		const FString LoadedPackageName = LoadedName.ToString();
+		PendingPackages.Remove(LoadedPackageName);
+		if (Result != EAsyncLoadingResult::Succeeded || !Package)
+		{
+			FailedPackages.Add(LoadedPackageName);
+			UE_LOG(Log_HyperScaleGlobals, Warning, TEXT("Async load of package %s failed"), *LoadedPackageName)
+		}
+	}));
+	return true;
+}
 
 UClass* FHSClassTranslator::GetClass(const uint64 ClassId)
 {
 	// first check in cache
-	if (ClassIdPtrCache.Contains(ClassId))
+	if (UClass** CachedClass = ClassIdPtrCache.Find(ClassId))
 	{
-		return *ClassIdPtrCache.Find(ClassId);
+		return *CachedClass;
 	}
 	// if no class path mapping exists, there is nothing to do, return nullptr
-	if (!ClassIdPathCache.Contains(ClassId)) { return nullptr; }
+	const FString* ClassName = ClassIdPathCache.Find(ClassId);
+	if (!ClassName) { return nullptr; }
 
-	// resolve class path, store in cache and return class ptr
-	const FString ClassName = *ClassIdPathCache.Find(ClassId);
-	const FSoftClassPath ClassPath(ClassName);
+	// resolve already loaded class only, missing class is loaded asynchronously and cached on next request
+	const FSoftClassPath ClassPath(*ClassName);
 	UClass* LoadedClassPtr = ClassPath.ResolveClass();
+	if (!LoadedClassPtr)
+	{
+		RequestPackageAsync(ClassPath.GetLongPackageName());
+		return nullptr;
+	}
 	ClassIdPtrCache.Add(ClassId, LoadedClassPtr);
 	return LoadedClassPtr;
 }
@@ -56,10 +118,18 @@ FHScaleClassInfoHolder FHSClassTranslator::GetClassId(const UObject* Object)
 
 UClass* FHSClassTranslator::GetClassFromPath(const FString& Path, const bool bIsStatic)
 {
+	// never block the game thread on loading, not loaded objects are requested asynchronously
+	const FSoftObjectPath ObjectPath(Path);
+	UObject* Object = ObjectPath.ResolveObject();
+	if (!Object)
+	{
+		RequestPackageAsync(ObjectPath.GetLongPackageName());
+		return nullptr;
+	}
+
 	if (bIsStatic)
 	{
-		const UObject* LoadObject = StaticLoadObject(UObject::StaticClass(), nullptr, *Path);
-		return LoadObject->GetClass();
+		return Object->GetClass();
 	}
-	return StaticLoadClass(UObject::StaticClass(), nullptr, *Path);
+	return Cast<UClass>(Object);
 }
\ No newline at end of file
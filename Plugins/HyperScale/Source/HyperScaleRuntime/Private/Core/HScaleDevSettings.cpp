@@ -86,3 +86,21 @@ const TArray<FHScale_ReplicationClassOptions>& UHScaleDevSettings::GetClassesRep
 {
 	return GetDefault<UHScaleDevSettings>()->ClassesReplicationOptions;
 }
+
+const TArray<FSoftClassPath>& UHScaleDevSettings::GetPreloadClasses()
+{
+	return GetDefault<UHScaleDevSettings>()->PreloadClasses;
+}
+
+float UHScaleDevSettings::GetPullDataBudgetMs()
+{
+	return GetDefault<UHScaleDevSettings>()->PullDataBudgetMs;
+}
+
+const FHScale_RPCOptions* UHScaleDevSettings::FindRPCOptions(const UFunction* Function)
+{
+	return GetDefault<UHScaleDevSettings>()->RPCOptions.FindByPredicate([Function](const FHScale_RPCOptions& Options)
+	{
+		return Options.Matches(Function);
+	});
+}
@@ -78,4 +78,12 @@ void FHScale_ServerConfigList::SelectExistingServer(const FHScale_ServerConfig&
 		EditorServerActiveIndex = ItemIndex;
 		SelectedServer = EditorServerList[ItemIndex];
 	}
+}
+
+bool FHScale_RPCOptions::Matches(const UFunction* Function) const
+{
+	if (!Function || Function->GetFName() != FunctionName) return false;
+
+	const UClass* Class = OwnerClass.Get();
+	return Class && Function->GetOwnerClass() && Function->GetOwnerClass()->IsChildOf(Class);
 }
\ No newline at end of file
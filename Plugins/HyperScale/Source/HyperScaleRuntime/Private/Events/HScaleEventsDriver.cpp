@@ -1,9 +1,31 @@
 ﻿#include "Events/HScaleEventsDriver.h"
 
+#include "Core/HScaleDevSettings.h"
 #include "NetworkLayer/HScaleConnection.h"
 #include "NetworkLayer/HScaleNetDriver.h"
+#include "NetworkLayer/HScaleNetworkSession.h"
 #include "ReplicationLayer/HScaleRepDriver.h"
 
+void FHScaleRPCBatch::Append(const quark_event_class_t EventId, const uint8* RPCData, const size_t RPCSize)
+{
+	check(RPCSize <= HSCALE_RPC_MAX_SIZE)
+	check(CanAppend(RPCSize))
+
+	if (IsEmpty())
+	{
+		EventClass = EventId;
+	}
+
+	const uint16 Id = EventId;
+	const uint8 RPCSizeByte = static_cast<uint8>(RPCSize);
+	std::memcpy(&Data[Size], &Id, sizeof(uint16));
+	Size += sizeof(uint16);
+	std::memcpy(&Data[Size], &RPCSizeByte, sizeof(uint8));
+	Size += sizeof(uint8);
+	std::memcpy(&Data[Size], RPCData, RPCSize);
+	Size += RPCSize;
+}
+
 void FHScaleEventsDriver::OnEntityDestroyed(const FHScaleNetGUID& EntityId)
 {
 	NetworkDestructionEntities.Remove(EntityId);
@@ -13,7 +35,10 @@ void FHScaleEventsDriver::OnEntityDestroyed(const FHScaleNetGUID& EntityId)
 void FHScaleEventsDriver::Tick(float DeltaSeconds)
 {
 	if (!IsValid(Connection) || !Connection->IsConnectionActive()) return;
+	// rpcs go first, so they reach entities before their despawn
+	SendPendingRPCs();
 	SendNetworkDestructionEvents();
+	SendForgetObjectsEvents();
 	DestroyMarkedObjectsLocally();
 	RemoveToDestroyEntities();
 }
@@ -37,17 +62,23 @@ bool FHScaleEventsDriver::SendObjectDespawnEvent(const uint8* Data, const size_t
 	return SendEvent(ObjectsDespawned, EHScaleEventRadius::Max, Data, Size);
 }
 
-// #TODO similar to objects despawn, this can also be batch sent
-bool FHScaleEventsDriver::SendForgetObjectsEvent(const FHScaleNetGUID& EntityId) const
+void FHScaleEventsDriver::MarkEntityForForget(const FHScaleNetGUID& EntityId)
 {
 	if (!EntityId.IsObject())
 	{
 		UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Received Invalid ObjectId to Forget %s"), *EntityId.ToString())
-		return false;
+		return;
 	}
 
-	uint64_t ObjectId = EntityId.Get();
-	return SendEvent(ForgetObjects, EntityId, reinterpret_cast<uint8_t*>(&ObjectId), sizeof(ObjectId));
+	ForgetEntities.Add(EntityId);
+}
+
+bool FHScaleEventsDriver::SendForgetObjectsEvent(const uint8* Data, const size_t Size) const
+{
+	if (!Size) return false;
+
+	// forget is handled by server only, there are no other recipients
+	return SendEvent(ForgetObjects, EHScaleEventRadius::None, Data, Size);
 }
 
 bool FHScaleEventsDriver::SendForgetPlayerEvent(const FHScaleNetGUID& EntityId) const
@@ -67,10 +98,10 @@ bool FHScaleEventsDriver::SendGetFreeObjectIds(bool ForPlayerObjects) const
 	return SendEvent(ForPlayerObjects ? GetFreePlayerObjectIds : GetFreeGlobalObjectIds, EHScaleEventRadius::None);
 }
 
-void FHScaleEventsDriver::HandleDisconnectedEvent(const quark::remote_event& Update)
+void FHScaleEventsDriver::HandleDisconnectedEvent(const FHScaleRemoteEvent& Update)
 {
-	const uint8_t* Data = Update.data();
-	const size_t DataSize = Update.size();
+	const uint8_t* Data = Update.Data;
+	const size_t DataSize = Update.Size;
 
 	size_t Index = 0;
 	while (Index + sizeof(uint32) <= DataSize)
@@ -85,10 +116,10 @@ void FHScaleEventsDriver::HandleDisconnectedEvent(const quark::remote_event& Upd
 	}
 }
 
-void FHScaleEventsDriver::HandleDespawnEvent(const quark::remote_event& Update)
+void FHScaleEventsDriver::HandleDespawnEvent(const FHScaleRemoteEvent& Update)
 {
-	const uint8_t* Data = Update.data();
-	const size_t DataSize = Update.size();
+	const uint8_t* Data = Update.Data;
+	const size_t DataSize = Update.Size;
 
 	size_t Index = 0;
 	while (Index + sizeof(uint64) <= DataSize)
@@ -109,9 +140,9 @@ void FHScaleEventsDriver::HandleDespawnEvent(const quark::remote_event& Update)
 	}
 }
 
-void FHScaleEventsDriver::HandleEvents(const quark::remote_event& Update)
+void FHScaleEventsDriver::HandleEvents(const FHScaleRemoteEvent& Update)
 {
-	uint16_t EventId = Update.event_class();
+	uint16_t EventId = Update.EventClass;
 
 	if (FHScalePropertyIdConverters::IsSystemEvent(EventId))
 	{
@@ -127,9 +158,9 @@ void FHScaleEventsDriver::HandleEvents(const quark::remote_event& Update)
 	}
 }
 
-void FHScaleEventsDriver::HandleSystemEvent(const quark::remote_event& Update)
+void FHScaleEventsDriver::HandleSystemEvent(const FHScaleRemoteEvent& Update)
 {
-	switch (const uint16_t EventId = Update.event_class())
+	switch (const uint16_t EventId = Update.EventClass)
 	{
 		case ObjectsDespawned:
 			HandleDespawnEvent(Update);
@@ -140,25 +171,19 @@ void FHScaleEventsDriver::HandleSystemEvent(const quark::remote_event& Update)
 			break;
 		case EHScale_QuarkEventType::GetFreeGlobalObjectIds:
 		{
-			int ID_amount = Update.size() / sizeof(uint64_t);
+			int ID_amount = Update.Size / sizeof(uint64_t);
 			const UHScaleNetDriver* NetDriver = Cast<UHScaleNetDriver>(Connection->Driver);
-			const uint64_t* ids = reinterpret_cast<const uint64_t*>(Update.data());
-			for (int i = 0; i < ID_amount; ++i)
-			{
-				NetDriver->GetHyperScaleConnection()->FreeGlobalObjectIDCache.Enqueue(ids[i]);
-			}
+			const uint64_t* ids = reinterpret_cast<const uint64_t*>(Update.Data);
+			NetDriver->GetHyperScaleConnection()->FreeGlobalObjectIDCache.EnqueueResponse(ids, ID_amount);
 			break;
 		}
 		case EHScale_QuarkEventType::GetFreePlayerObjectIds:
 		{
 			UE_LOG(Log_HyperScaleEvents, Log, TEXT("GetFreePlayerObjectIds received"));
-			int ID_amount = Update.size() / sizeof(uint64_t);
+			int ID_amount = Update.Size / sizeof(uint64_t);
 			const UHScaleNetDriver* NetDriver = Cast<UHScaleNetDriver>(Connection->Driver);
-			const uint64_t* ids = reinterpret_cast<const uint64_t*>(Update.data());
-			for (int i = 0; i < ID_amount; ++i)
-			{
-				NetDriver->GetHyperScaleConnection()->FreePlayerObjectIDCache.Enqueue(ids[i]);
-			}
+			const uint64_t* ids = reinterpret_cast<const uint64_t*>(Update.Data);
+			NetDriver->GetHyperScaleConnection()->FreePlayerObjectIDCache.EnqueueResponse(ids, ID_amount);
 			break;
 		}
 		default:
@@ -231,7 +256,7 @@ void FHScaleEventsDriver::MarkEntityForToDestroy(const FHScaleNetGUID& EntityId)
 	}
 }
 
-quark::session* FHScaleEventsDriver::GetNetworkSession() const
+IHScaleNetworkSession* FHScaleEventsDriver::GetNetworkSession() const
 {
 	if (!IsValid(Connection) || !Connection->IsConnectionActive()) return nullptr;
 
@@ -248,23 +273,15 @@ bool FHScaleEventsDriver::SendEvent(const quark_event_class_t EventId, const EHS
 	return SendEvent(EventId, Radius, Ar.GetData(), Ar.GetNumBytes());
 }
 
-bool FHScaleEventsDriver::SendEvent(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, const uint8* Data, const size_t Size) const
+bool FHScaleEventsDriver::SendEvent(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, const uint8* Data, const size_t Size, const quark::qos Qos) const
 {
-	const quark::local_event Event(EventId, quark::recipient::object(EntityId.Get()), Data, Size);
-	quark::session* Session = GetNetworkSession();
+	IHScaleNetworkSession* Session = GetNetworkSession();
 	if (!Session) return false;
 
-	const quark::error ResultError = Session->send(quark::local_update::event(Event)).error();
-	if (ResultError.is_error())
-	{
-		UE_LOG(Log_HyperScaleEvents, Error, TEXT("Quark event send error: %hs"), ResultError.message());
-		return false;
-	}
-
-	return true;
+	return Session->SendEvent(EventId, quark::recipient::object(EntityId.Get()), Data, Size, Qos);
 }
 
-bool FHScaleEventsDriver::SendEvent(const quark_event_class_t EventId, const EHScaleEventRadius Radius, const uint8* Data, const size_t Size) const
+bool FHScaleEventsDriver::SendEvent(const quark_event_class_t EventId, const EHScaleEventRadius Radius, const uint8* Data, const size_t Size, const quark::qos Qos) const
 {
 	quark::recipient Recipient = quark::recipient::radius(quark::radius(HS_EVENT_RADIUS_MEDIUM));
 	if (Radius == EHScaleEventRadius::None)
@@ -283,18 +300,78 @@ bool FHScaleEventsDriver::SendEvent(const quark_event_class_t EventId, const EHS
 	{
 		Recipient = quark::recipient::radius(quark::radius::max());
 	}
-	const quark::local_event Event(EventId, Recipient, Data, Size);
-	quark::session* Session = GetNetworkSession();
+	IHScaleNetworkSession* Session = GetNetworkSession();
 	if (!Session) return false;
 
-	const quark::error ResultError = Session->send(quark::local_update::event(Event)).error();
-	if (ResultError.is_error())
+	return Session->SendEvent(EventId, Recipient, Data, Size, Qos);
+}
+
+void FHScaleEventsDriver::QueueRPC(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, const bool bReliable, const FBitWriter& Ar)
+{
+	FHScaleRPCBatchTarget Target;
+	Target.EntityId = EntityId;
+	Target.bReliable = bReliable;
+	QueueRPC(EventId, Target, Ar);
+}
+
+void FHScaleEventsDriver::QueueRPC(const quark_event_class_t EventId, const EHScaleEventRadius Radius, const bool bReliable, const FBitWriter& Ar)
+{
+	FHScaleRPCBatchTarget Target;
+	Target.Radius = Radius;
+	Target.bReliable = bReliable;
+	QueueRPC(EventId, Target, Ar);
+}
+
+void FHScaleEventsDriver::QueueRPC(const quark_event_class_t EventId, const FHScaleRPCBatchTarget& Target, const FBitWriter& Ar)
+{
+	const size_t Size = Ar.GetNumBytes();
+	if (!(PendingRPCsTarget == Target) || !PendingRPCs.CanAppend(Size))
 	{
-		UE_LOG(Log_HyperScaleEvents, Error, TEXT("Quark event send error: %hs"), ResultError.message());
-		return false;
+		SendPendingRPCs();
+		PendingRPCsTarget = Target;
+	}
+	PendingRPCs.Append(EventId, Ar.GetData(), Size);
+}
+
+void FHScaleEventsDriver::SendPendingRPCs()
+{
+	if (PendingRPCs.IsEmpty()) return;
+
+	const quark::qos Qos = PendingRPCsTarget.bReliable ? quark::qos::reliable : quark::qos::unreliable;
+	bool bSuccess;
+	if (PendingRPCsTarget.EntityId.IsValid())
+	{
+		bSuccess = SendEvent(PendingRPCs.EventClass, PendingRPCsTarget.EntityId, PendingRPCs.Data, PendingRPCs.Size, Qos);
+	}
+	else
+	{
+		bSuccess = SendEvent(PendingRPCs.EventClass, PendingRPCsTarget.Radius, PendingRPCs.Data, PendingRPCs.Size, Qos);
+	}
+	UE_LOG(Log_HyperScaleEvents, VeryVerbose, TEXT("RPC batch for %s radius %d of size %llu send status %d"),
+		*PendingRPCsTarget.EntityId.ToString(), static_cast<int32>(PendingRPCsTarget.Radius), static_cast<uint64>(PendingRPCs.Size), bSuccess)
+	PendingRPCs.Reset();
+}
+
+const FHScaleRPCSendOptions& FHScaleEventsDriver::GetRPCSendOptions(UFunction* Function)
+{
+	if (const FHScaleRPCSendOptions* CachedOptions = RPCSendOptionsCache.Find(Function))
+	{
+		return *CachedOptions;
+	}
+
+	FHScaleRPCSendOptions& Options = RPCSendOptionsCache.Add(Function);
+	Options.bReliable = !!(Function->FunctionFlags & FUNC_NetReliable);
+
+	if (const FHScale_RPCOptions* RPCOptions = UHScaleDevSettings::FindRPCOptions(Function))
+	{
+		Options.Radius = RPCOptions->Radius;
+		if (RPCOptions->Qos != EHScale_EventQos::Default)
+		{
+			Options.bReliable = RPCOptions->Qos == EHScale_EventQos::Reliable;
+		}
 	}
 
-	return true;
+	return Options;
 }
 
 FHScaleNetworkBibliothec* FHScaleEventsDriver::GetBibliothec() const
@@ -346,6 +423,37 @@ void FHScaleEventsDriver::SendNetworkDestructionEvents()
 	ClearNetworkDestructionEntities();
 }
 
+void FHScaleEventsDriver::SendForgetObjectsEvents()
+{
+	if (ForgetEntities.IsEmpty()) return;
+
+	uint8 ObjectIdsData[QUARK_MAX_PAYLOAD_LEN];
+	size_t Index = 0;
+	bool bSuccess = true;
+
+	// entities are already removed from bibliothec, so only their ids are packed
+	for (const FHScaleNetGUID& EntityId : ForgetEntities)
+	{
+		if (Index + sizeof(uint64) > QUARK_MAX_PAYLOAD_LEN)
+		{
+			bSuccess &= SendForgetObjectsEvent(ObjectIdsData, Index);
+			Index = 0;
+		}
+
+		const uint64 Obj = EntityId.Get();
+		std::memcpy(&ObjectIdsData[Index], &Obj, sizeof(uint64));
+		Index += sizeof(uint64);
+	}
+
+	if (Index > 0)
+	{
+		bSuccess &= SendForgetObjectsEvent(ObjectIdsData, Index);
+	}
+
+	UE_LOG(Log_HyperScaleEvents, VeryVerbose, TEXT("Forget objects events for %d entities send status %d"), ForgetEntities.Num(), bSuccess)
+	ForgetEntities.Reset();
+}
+
 void FHScaleEventsDriver::DestroyMarkedObjectsLocally()
 {
 	if (!IsValid(Connection)) return;
@@ -391,4 +499,4 @@ void FHScaleEventsDriver::RemoveToDestroyEntities()
 	ClearToDestroyEntities();
 }
 
-void FHScaleEventsDriver::HandleReservedEvent(const quark::remote_event& Update) {}
\ No newline at end of file
+void FHScaleEventsDriver::HandleReservedEvent(const FHScaleRemoteEvent& Update) {}
\ No newline at end of file
@@ -1,11 +1,225 @@
 ﻿#include "Events/HScaleEventsSerializer.h"
 
 #include "Core/HScaleCommons.h"
+#include "Core/HScaleResources.h"
 #include "Net/RepLayout.h"
 #include "NetworkLayer/HScalePackageMap.h"
 #include "Utils/HScaleObjectSerializationHelpers.h"
 #include "Utils/HScaleStatics.h"
 
+bool FHScaleEventsSerializer::SerializeRPCParams(FBitWriter& Writer, const FRepLayout& RepLayout, const uint8* Parameters, UHScalePackageMap* PkgMap)
+{
+	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, &RepLayout, Cmds);
+	const TArray<FRepParentCmd>& Parents = HSCALE_GET_PRIVATE(FRepLayout, &RepLayout, Parents);
+
+	bool bSuccess = true;
+	for (int32 i = 0; i < Parents.Num() && bSuccess; i++)
+	{
+		// same as in SendPropertiesForRPC, params with default value are skipped but bools are always sent
+		const bool bToSend = CastField<FBoolProperty>(Parents[i].Property) || !Parents[i].Property->Identical_InContainer(Parameters, nullptr, Parents[i].ArrayIndex);
+		Writer.WriteBit(bToSend ? 1 : 0);
+
+		if (!bToSend) continue;
+
+		for (int32 CmdIndex = Parents[i].CmdStart; CmdIndex < Parents[i].CmdEnd && !Writer.IsError() && bSuccess; CmdIndex++)
+		{
+			const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
+
+			if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
+			{
+				bSuccess &= SerializeDynArray(Writer, Cmd, Cmds[CmdIndex + 1], Parameters + Cmd.Offset, PkgMap);
+				CmdIndex = Cmd.EndCmd - 1; // The -1 to handle the ++ in the for loop
+				continue;
+			}
+
+			bSuccess &= SerializeProperty(Writer, Cmd, Parameters + Cmd.Offset, PkgMap);
+		}
+	}
+
+	return bSuccess && !Writer.IsError();
+}
+
+bool FHScaleEventsSerializer::SerializeProperty(FBitWriter& Writer, const FRepLayoutCmd& Cmd, const uint8* Data, UHScalePackageMap* PkgMap)
+{
+	check(Cmd.Property)
+
+	switch (Cmd.Type)
+	{
+		case ERepLayoutCmdType::PropertyBool:
+		case ERepLayoutCmdType::PropertyNativeBool:
+		case ERepLayoutCmdType::PropertyByte:
+			Cmd.Property->NetSerializeItem(Writer, PkgMap, const_cast<uint8*>(Data));
+			return true;
+
+		case ERepLayoutCmdType::PropertyFloat:
+			return SerializeValue<float>(Writer, Data);
+
+		case ERepLayoutCmdType::PropertyInt:
+			return SerializeValue<int32>(Writer, Data);
+
+		case ERepLayoutCmdType::PropertyUInt32:
+			return SerializeValue<uint32>(Writer, Data);
+
+		case ERepLayoutCmdType::PropertyUInt64:
+			return SerializeValue<uint64>(Writer, Data);
+
+		case ERepLayoutCmdType::PropertyString:
+			return SerializeValue<FString>(Writer, Data);
+
+		case ERepLayoutCmdType::PropertyName:
+			return SerializeValue<FName>(Writer, Data);
+
+		case ERepLayoutCmdType::Property:
+		{
+			if (Cmd.Property->IsA(FDoubleProperty::StaticClass()))
+			{
+				return SerializeValue<double>(Writer, Data);
+			}
+
+			if (Cmd.Property->IsA(FInt64Property::StaticClass()))
+			{
+				return SerializeValue<int64>(Writer, Data);
+			}
+
+			if (Cmd.Property->IsA(FUInt16Property::StaticClass()))
+			{
+				return SerializeValue<uint16>(Writer, Data);
+			}
+
+			if (Cmd.Property->IsA(FInt16Property::StaticClass()))
+			{
+				return SerializeValue<int16>(Writer, Data);
+			}
+
+			if (Cmd.Property->IsA(FTextProperty::StaticClass()))
+			{
+				return SerializeValue<FText>(Writer, Data);
+			}
+
+			const FStructProperty* StructProp = CastField<FStructProperty>(Cmd.Property);
+			if (StructProp && StructProp->Struct->StructFlags & STRUCT_NetSerializeNative)
+			{
+				bool bOutSuccess = true;
+				StructProp->Struct->GetCppStructOps()->NetSerialize(Writer, PkgMap, bOutSuccess, const_cast<uint8*>(Data));
+				return true;
+			}
+
+			UE_LOG(Log_HyperScaleEvents, Warning, TEXT("Property %s is not supported as rpc parameter"), *Cmd.Property->GetName())
+			return false;
+		}
+
+		case ERepLayoutCmdType::RepMovement:
+			return SerializeNetSerializeValue<FRepMovement>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyVector:
+			return SerializeNetSerializeValue<FVector>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyRotator:
+			return SerializeNetSerializeValue<FRotator>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyVector100:
+			return SerializeNetSerializeValue<FVector_NetQuantize100>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyVector10:
+			return SerializeNetSerializeValue<FVector_NetQuantize10>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyVectorNormal:
+			return SerializeNetSerializeValue<FVector_NetQuantizeNormal>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyVectorQ:
+			return SerializeNetSerializeValue<FVector_NetQuantize>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyPlane:
+			return SerializeNetSerializeValue<FPlane>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyNetId:
+			return SerializeNetSerializeValue<FUniqueNetIdRepl>(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::PropertyObject:
+		case ERepLayoutCmdType::PropertyWeakObject:
+			return SerializeObjectPtr(Writer, CastFieldChecked<FObjectPropertyBase>(Cmd.Property)->GetObjectPropertyValue(Data), PkgMap);
+
+		case ERepLayoutCmdType::PropertyInterface:
+			return SerializeObjectPtr(Writer, reinterpret_cast<const FScriptInterface*>(Data)->GetObject(), PkgMap);
+
+		case ERepLayoutCmdType::PropertySoftObject:
+			return SerializeSoftObjectPtr(Writer, Data, PkgMap);
+
+		case ERepLayoutCmdType::DynamicArray:
+			UE_LOG(Log_HyperScaleEvents, Warning, TEXT("Dynamic arrays should be handled separately"))
+			return false;
+
+		case ERepLayoutCmdType::NetSerializeStructWithObjectReferences:
+		case ERepLayoutCmdType::Return:
+		default:
+			UE_LOG(Log_HyperScaleEvents, Warning, TEXT("Received not yet implemented serialization type"));
+			return false;
+	}
+}
+
+bool FHScaleEventsSerializer::SerializeObjectPtr(FBitWriter& Writer, UObject* Object, UHScalePackageMap* PkgMap)
+{
+	if (!Object) // this would be a null pointer transfer
+	{
+		Writer.WriteBit(0); // signifying its a NetGUID
+		FHScaleNetGUID GUID;
+		Writer << GUID;
+	}
+	else if (Object->IsFullNameStableForNetworking())
+	{
+		Writer.WriteBit(1); // signifying contains full name
+		FString FullName = Object->GetFullName();
+		Writer << FullName;
+	}
+	else
+	{
+		FHScaleNetGUID HScaleNetGUID = PkgMap->FindEntityNetGUID(Object);
+		if (!HScaleNetGUID.IsObject()) { return false; }
+
+		Writer.WriteBit(0); // signifying it contains HScaleNetGUID
+		Writer << HScaleNetGUID;
+	}
+	return true;
+}
+
+bool FHScaleEventsSerializer::SerializeSoftObjectPtr(FBitWriter& Writer, const uint8* Data, UHScalePackageMap* PkgMap)
+{
+	const FSoftObjectPtr& SoftPtr = *reinterpret_cast<const FSoftObjectPtr*>(Data);
+
+	// loaded objects are sent as object ptr, the rest by path
+	if (UObject* Object = SoftPtr.Get())
+	{
+		Writer.WriteBit(1); // signifying its a objectptr
+		return SerializeObjectPtr(Writer, Object, PkgMap);
+	}
+
+	Writer.WriteBit(0); // signifying its a String
+	FString Path = SoftPtr.ToSoftObjectPath().ToString();
+	Writer << Path;
+	return true;
+}
+
+bool FHScaleEventsSerializer::SerializeDynArray(FBitWriter& Writer, const FRepLayoutCmd& Cmd, const FRepLayoutCmd& ElementCmd, const uint8* Data, UHScalePackageMap* PkgMap)
+{
+	if (EnumHasAnyFlags(ElementCmd.Flags, ERepLayoutCmdFlags::IsEmptyArrayStruct))
+	{
+		return false;
+	}
+
+	const FScriptArray* Array = reinterpret_cast<const FScriptArray*>(Data);
+	uint16 ArrayNum = static_cast<uint16>(FMath::Min(Array->Num(), static_cast<int32>(UINT16_MAX)));
+	Writer << ArrayNum;
+
+	const uint8* ElementsData = static_cast<const uint8*>(Array->GetData());
+	bool bResult = true;
+	for (int32 i = 0; i < ArrayNum && !Writer.IsError() && bResult; i++)
+	{
+		bResult &= SerializeProperty(Writer, ElementCmd, ElementsData + i * Cmd.ElementSize + ElementCmd.Offset, PkgMap);
+	}
+
+	return bResult;
+}
+
 bool FHScaleEventsSerializer::Serialize(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap)
 {
 	switch (Cmd.Type)
@@ -116,7 +330,7 @@ bool FHScaleEventsSerializer::Serialize(FBitWriter& Writer, FBitReader& Reader,
 	}
 }
 
-bool FHScaleEventsSerializer::SerializeDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const FRepLayoutCmd& Cmd, const bool bOnSend)
+bool FHScaleEventsSerializer::SerializeDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const FRepLayoutCmd& Cmd)
 {
 	if (EnumHasAnyFlags(Cmd.Flags, ERepLayoutCmdFlags::IsEmptyArrayStruct))
 	{
@@ -132,14 +346,12 @@ bool FHScaleEventsSerializer::SerializeDynArray(FBitWriter& Writer, FBitReader&
 	{
 		if (FHScaleStatics::IsObjectDataRepCmd(Cmd))
 		{
-			if (bOnSend) { bResult &= ReadObjectPtr(Writer, Reader, PkgMap); }
-			else { bResult &= WriteObjectPtr(Writer, Reader, PkgMap); }
+			bResult &= WriteObjectPtr(Writer, Reader, PkgMap);
 			continue;
 		}
 		if (Cmd.Type == ERepLayoutCmdType::PropertySoftObject)
 		{
-			if (bOnSend) { bResult &= ReadSoftObjectPtr(Writer, Reader, Cmd, PkgMap); }
-			else { bResult &= WriteSoftObjectPtr(Writer, Reader, Cmd, PkgMap); }
+			bResult &= WriteSoftObjectPtr(Writer, Reader, Cmd, PkgMap);
 			continue;
 		}
 		bResult &= Serialize(Writer, Reader, Cmd, PkgMap);
@@ -148,38 +360,6 @@ bool FHScaleEventsSerializer::SerializeDynArray(FBitWriter& Writer, FBitReader&
 	return bResult;
 }
 
-bool FHScaleEventsSerializer::ReadObjectPtr(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap)
-{
-	TArray<FHScaleOuterChunk> OuterChunks;
-	FHScaleObjectSerializationHelper::ReadOuterChunkFromBunch(Reader, OuterChunks, PkgMap);
-
-	if (OuterChunks.IsEmpty()) { return false; }
-	const FNetworkGUID NetGUID = OuterChunks[OuterChunks.Num() - 1].NetGUID;
-
-	UObject* Object = PkgMap->GetObjectFromNetGUID(NetGUID, true);
-	if (!Object) // this would be a null pointer transfer
-	{
-		Writer.WriteBit(0); // signifying its a NetGUID
-		FHScaleNetGUID GUID;
-		Writer << GUID;
-	}
-	else if (Object->IsFullNameStableForNetworking())
-	{
-		Writer.WriteBit(1); // signifying contains full name
-		FString FullName = Object->GetFullName();
-		Writer << FullName;
-	}
-	else
-	{
-		FHScaleNetGUID HScaleNetGUID = PkgMap->FindEntityNetGUID(NetGUID);
-		if (!HScaleNetGUID.IsObject()) { return false; }
-
-		Writer.WriteBit(0); // signifying it contains HScaleNetGUID
-		Writer << HScaleNetGUID;
-	}
-	return true;
-}
-
 bool FHScaleEventsSerializer::WriteObjectPtr(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap)
 {
 	if (!!Reader.ReadBit())
@@ -223,27 +403,6 @@ bool FHScaleEventsSerializer::WriteObjectPtr(FBitWriter& Writer, FBitReader& Rea
 }
 
 
-bool FHScaleEventsSerializer::ReadSoftObjectPtr(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap)
-{
-	bool bObjectPtr = false;;
-	Reader.UsingCustomVersion(FEngineNetworkCustomVersion::Guid);
-
-	if (Reader.EngineNetVer() >= FEngineNetworkCustomVersion::SoftObjectPtrNetGuids)
-	{
-		const bool bUsePath = !!Reader.ReadBit();
-		if (!bUsePath) bObjectPtr = true;;
-	}
-
-	if (bObjectPtr)
-	{
-		Writer.WriteBit(1); // signifying its a objectptr
-		return ReadObjectPtr(Writer, Reader, PkgMap);
-	}
-
-	Writer.WriteBit(0); // signifying its a String
-	return SerializeDataType<FString>(Writer, Reader);
-}
-
 bool FHScaleEventsSerializer::WriteSoftObjectPtr(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap)
 {
 	Writer.UsingCustomVersion(FEngineNetworkCustomVersion::Guid);
@@ -263,14 +422,9 @@ bool FHScaleEventsSerializer::WriteSoftObjectPtr(FBitWriter& Writer, FBitReader&
 	return SerializeDataType<FString>(Writer, Reader);
 }
 
-bool FHScaleEventsSerializer::ReadDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const TArray<FRepLayoutCmd>::ElementType& Cmd)
-{
-	return SerializeDynArray(Writer, Reader, PkgMap, Cmd, true);
-}
-
 bool FHScaleEventsSerializer::WriteDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const TArray<FRepLayoutCmd>::ElementType& Cmd)
 {
-	return SerializeDynArray(Writer, Reader, PkgMap, Cmd, false);
+	return SerializeDynArray(Writer, Reader, PkgMap, Cmd);
 }
 
 bool FHScaleEventsSerializer::SerializeNetSerializeStruct(FBitReader& Reader, FBitWriter& Writer, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap)
@@ -321,4 +475,19 @@ bool FHScaleEventsSerializer::SerializeNetSerializeTypes(FBitWriter& Writer, FBi
 	Val.NetSerialize(Reader, PkgMap, bOutSuccess);
 	Val.NetSerialize(Writer, PkgMap, bOutSuccess);
 	return true;
+}
+
+template<typename T>
+bool FHScaleEventsSerializer::SerializeValue(FBitWriter& Writer, const uint8* Data)
+{
+	Writer << *const_cast<T*>(reinterpret_cast<const T*>(Data));
+	return true;
+}
+
+template<typename T>
+bool FHScaleEventsSerializer::SerializeNetSerializeValue(FBitWriter& Writer, const uint8* Data, UHScalePackageMap* PkgMap)
+{
+	bool bOutSuccess;
+	const_cast<T*>(reinterpret_cast<const T*>(Data))->NetSerialize(Writer, PkgMap, bOutSuccess);
+	return true;
 }
\ No newline at end of file
@@ -10,24 +10,61 @@
 #include "Net/RepLayout.h"
 #include "Utils/HScaleStatics.h"
 
-void FHScaleEventsDriver::HandleApplicationEvents(const quark::remote_event& Update)
+void FHScaleEventsDriver::HandleApplicationEvents(const FHScaleRemoteEvent& Update)
 {
 	if (!IsValid(Connection)) return;
 	TObjectPtr<UHScaleNetDriver> NetDriver = Cast<UHScaleNetDriver>(Connection->Driver);
 	if (!IsValid(NetDriver)) return;
-	UHScalePackageMap* PkgMap = Cast<UHScalePackageMap>(Connection->PackageMap);
-	if (!IsValid(PkgMap)) return;
 
-	UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Received event of type %d and sender isplayer %d of size %llu"), Update.event_class(), Update.sender().is_player(), Update.size())
+	UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Received event of type %d and sender isplayer %d of size %llu"), Update.EventClass, Update.bFromPlayer, Update.Size)
 
-	if (Update.size() == 0)
+	if (Update.Size == 0)
 	{
 		UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Received event is of empty size exiting"))
 		return;
 	}
 
-	const uint8_t* Data = Update.data();
-	FBitReader Reader(Data, Update.size() * 8);
+	const uint8 PrevActValue = NetDriver->bActAsClient;
+	NetDriver->bActAsClient = 1;
+
+	// payload is series of rpcs, each prefixed with its event id and size
+	const uint8_t* Data = Update.Data;
+	size_t Index = 0;
+	while (Index + HSCALE_RPC_HEADER_SIZE <= Update.Size)
+	{
+		uint16 EventId = 0;
+		std::memcpy(&EventId, Data + Index, sizeof(uint16));
+		Index += sizeof(uint16);
+		uint8 RPCSize = 0;
+		std::memcpy(&RPCSize, Data + Index, sizeof(uint8));
+		Index += sizeof(uint8);
+
+		if (Index + RPCSize > Update.Size)
+		{
+			UE_LOG(Log_HyperScaleEvents, Warning, TEXT("Received malformed rpc %d of size %d in event of size %llu"), EventId, RPCSize, Update.Size)
+			break;
+		}
+
+		HandleRPC(EventId, Data + Index, RPCSize);
+		Index += RPCSize;
+	}
+
+	NetDriver->bActAsClient = PrevActValue;
+}
+
+void FHScaleEventsDriver::HandleRPC(const uint16 EventId, const uint8* Data, const size_t Size)
+{
+	if (!FHScalePropertyIdConverters::IsApplicationEvent(EventId))
+	{
+		UE_LOG(Log_HyperScaleEvents, Warning, TEXT("Received rpc with non application event id %d"), EventId)
+		return;
+	}
+
+	TObjectPtr<UHScaleNetDriver> NetDriver = Cast<UHScaleNetDriver>(Connection->Driver);
+	UHScalePackageMap* PkgMap = Cast<UHScalePackageMap>(Connection->PackageMap);
+	if (!IsValid(PkgMap)) return;
+
+	FBitReader Reader(Data, Size * 8);
 
 	FHScaleNetGUID ReceiverId;
 	Reader << ReceiverId;
@@ -40,7 +77,6 @@ void FHScaleEventsDriver::HandleApplicationEvents(const quark::remote_event& Upd
 		UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Received event for unknown EntityId %s"), *ReceiverId.ToString())
 		return;
 	}
-	const uint16 EventId = Update.event_class();
 	const uint16 Handle = FHScalePropertyIdConverters::GetHandleFromAppEventId(EventId);
 
 	const FClassNetCache* ClassCache = NetDriver->NetCache->GetClassNetCache(Object->GetClass());
@@ -72,8 +108,6 @@ void FHScaleEventsDriver::HandleApplicationEvents(const quark::remote_event& Upd
 		return;
 	}
 
-	const uint8 PrevActValue = NetDriver->bActAsClient;
-	NetDriver->bActAsClient = 1;
 	if (Function->NumParms == 0)
 	{
 		Object->ProcessEvent(Function, nullptr);
@@ -141,13 +175,11 @@ void FHScaleEventsDriver::HandleApplicationEvents(const quark::remote_event& Upd
 			UE_LOG(Log_HyperScaleEvents, Warning, TEXT("Failed to write RPC params for Entity %s with eventId %d"), *ReceiverId.ToString(), EventId)
 		}
 	}
-
-	NetDriver->bActAsClient = PrevActValue;
 }
 
 void FHScaleEventsDriver::ProcessRemoteFunctionForChannelPrivate_HS(UActorChannel* Ch, const FClassNetCache* ClassCache,
 	const FFieldNetCache* FieldCache, UObject* TargetObject,
-	UFunction* Function, void* Parameters) const
+	UFunction* Function, void* Parameters)
 {
 	TObjectPtr<UNetDriver> NetDriver = Cast<UHScaleNetDriver>(Connection->Driver);
 	const bool bIsServer = NetDriver->IsServer();
@@ -177,7 +209,6 @@ void FHScaleEventsDriver::ProcessRemoteFunctionForChannelPrivate_HS(UActorChanne
 	// Form the RPC preamble.
 	FOutBunch Bunch(Ch, false);
 
-	// TODO: In high scale SDK, use bReliable to send reliable events
 	// Reliability.
 	//warning: RPCs might overflow, preventing reliable functions from getting thorough.
 	if (Function->FunctionFlags & FUNC_NetReliable)
@@ -209,29 +240,6 @@ void FHScaleEventsDriver::ProcessRemoteFunctionForChannelPrivate_HS(UActorChanne
 		return;
 	}
 
-	// Init bunch for rpc
-#if UE_NET_TRACE_ENABLED
-	SetTraceCollector(Bunch, UE_NET_TRACE_CREATE_COLLECTOR(ENetTraceVerbosity::Trace));
-#endif
-
-	FNetBitWriter TempWriter(Bunch.PackageMap, 0);
-
-#if UE_NET_TRACE_ENABLED
-	// Create trace collector if tracing is enabled for the target bunch
-	SetTraceCollector(TempWriter, GetTraceCollector(Bunch) ? UE_NET_TRACE_CREATE_COLLECTOR(ENetTraceVerbosity::Trace) : nullptr);
-	ON_SCOPE_EXIT { UE_NET_TRACE_DESTROY_COLLECTOR(GetTraceCollector(TempWriter)); };
-#endif // UE_NET_TRACE_ENABLED
-
-	// Use the replication layout to send the rpc parameter values
-	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
-
-	RepLayout->SendPropertiesForRPC(Function, Ch, TempWriter, Parameters);
-
-	if (TempWriter.IsError())
-	{
-		UE_LOG(LogNet, Log, TEXT("Error: Can't send function '%s' on '%s': Failed to serialize properties"), *GetNameSafe(Function), *GetFullNameSafe(TargetObject));
-	}
-
 	const int32 MaxFieldNetIndex = ClassCache->GetMaxIndex() + 1;
 	check(FieldCache->FieldNetIndex < MaxFieldNetIndex);
 	check(FieldCache->FieldNetIndex < UINT16_MAX)
@@ -239,7 +247,7 @@ void FHScaleEventsDriver::ProcessRemoteFunctionForChannelPrivate_HS(UActorChanne
 	const bool bIsServerMulticast = bIsServer && (Function->FunctionFlags & FUNC_NetMulticast);
 
 	uint16 EventId = FHScalePropertyIdConverters::GetAppEventIdFromHandle(FieldCache->FieldNetIndex);
-	FBitWriter Writer(8 * QUARK_MAX_PAYLOAD_LEN);
+	FBitWriter Writer(8 * HSCALE_RPC_MAX_SIZE);
 	Writer << EntityNetGUID;
 
 	if (bIsServerMulticast)
@@ -268,76 +276,29 @@ void FHScaleEventsDriver::ProcessRemoteFunctionForChannelPrivate_HS(UActorChanne
 	bool bToSend = true;
 	if (Function->NumParms > 0)
 	{
-		FBitReader Reader(TempWriter.GetData(), TempWriter.GetNumBits());
-		bToSend &= ReadRPCParams(Writer, Reader, RepLayout);
+		// params are written straight from the parameters memory, without going through SendPropertiesForRPC
+		const TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
+		bToSend &= FHScaleEventsSerializer::SerializeRPCParams(Writer, *RepLayout, static_cast<const uint8*>(Parameters), PkgMap);
+	}
+	if (Writer.IsError())
+	{
+		UE_LOG(Log_HyperScaleEvents, Warning, TEXT("RPC %s on %s does not fit into event payload"), *GetNameSafe(Function), *GetFullNameSafe(TargetObject))
+		return;
 	}
 	if (bToSend)
 	{
-		bool bSuccess;
+		const FHScaleRPCSendOptions& Options = GetRPCSendOptions(Function);
 		if (bIsServerMulticast)
 		{
-			// #todo: In production SDK this should be configurable per RPC, we can fetch it from 
-			bSuccess = SendEvent(EventId, EHScaleEventRadius::Medium, Writer);
+			QueueRPC(EventId, Options.Radius, Options.bReliable, Writer);
 		}
 		else
 		{
-			bSuccess = SendEvent(EventId, EntityNetGUID, Writer);
-		}
-		
-		UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Event sending result for EventId %d bSuccess %d"), EventId, bSuccess)
-	}
-}
-
-bool FHScaleEventsDriver::ReadRPCParams(::FBitWriter& Writer, ::FBitReader& Reader, const TSharedPtr<FRepLayout>& RepLayout) const
-{
-	if (Reader.AtEnd()) return false;
-
-	UHScalePackageMap* PkgMap = Cast<UHScalePackageMap>(Connection->PackageMap);
-	// payload contains series of property handles(packed int) and property data
-	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, RepLayout.Get(), Cmds);
-	const TArray<FRepParentCmd>& Parents = HSCALE_GET_PRIVATE(FRepLayout, RepLayout.Get(), Parents);
-
-	bool bSuccess = true;
-	for (int32 i = 0; i < Parents.Num(); i++)
-	{
-		bool bToRead = false;
-		if (CastField<FBoolProperty>(Parents[i].Property)) { bToRead = true; }
-		if (!bToRead)
-		{
-			bToRead = !!Reader.ReadBit();
+			QueueRPC(EventId, EntityNetGUID, Options.bReliable, Writer);
 		}
-		Writer.WriteBit(bToRead ? 1 : 0);
-
-		if (bToRead)
-		{
-			for (int32 CmdIndex = Parents[i].CmdStart; CmdIndex < Parents[i].CmdEnd && !Writer.IsError() && bSuccess; CmdIndex++)
-			{
-				const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
 
-				if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
-				{
-					bSuccess &= FHScaleEventsSerializer::ReadDynArray(Writer, Reader, PkgMap, Cmds[CmdIndex + 1]);
-					CmdIndex = Cmd.EndCmd - 1; // The -1 to handle the ++ in the for loop
-					continue;
-				}
-				if (FHScaleStatics::IsObjectDataRepCmd(Cmd))
-				{
-					bSuccess &= FHScaleEventsSerializer::ReadObjectPtr(Writer, Reader, PkgMap);
-					continue;
-				}
-
-				if (Cmd.Type == ERepLayoutCmdType::PropertySoftObject)
-				{
-					bSuccess &= FHScaleEventsSerializer::ReadSoftObjectPtr(Writer, Reader, Cmd, PkgMap);
-					continue;
-				}
-
-				bSuccess &= FHScaleEventsSerializer::Serialize(Writer, Reader, Cmd, PkgMap);
-			}
-		}
+		UE_LOG(Log_HyperScaleEvents, Verbose, TEXT("Event queued for EventId %d"), EventId)
 	}
-
-	return bSuccess;
 }
 
 bool FHScaleEventsDriver::WriteRPCParams(::FBitWriter& Writer, ::FBitReader& Reader, const TSharedPtr<FRepLayout>& RepLayout) const
@@ -419,80 +419,94 @@ void HScaleTypes::FHScaleOwnerProperty::Serialize(TArray<FHScaleAttributesUpdate
 	}
 }
 
-HScaleTypes::FHScaleSplitStringProperty::FHScaleSplitStringProperty(const uint8_t MaxLength)
-	: bIsPartial(false), MaxLength(MaxLength), Count(0)
+HScaleTypes::FHScaleSplitChunkBuffer::FHScaleSplitChunkBuffer(const uint8 InMaxChunks)
+	: Buffer(InMaxChunks * SlotSize, 0), MaxChunks(InMaxChunks)
 {
-	for (uint8 i = 0; i < MaxLength; ++i)
-	{
-		SplitStrings.push_back(std::move(CreateFromTypeId(EHScaleMemoryTypeId::String)));
-	}
+	check(MaxChunks <= sizeof(DirtyBits) * 8)
+	Timestamps.SetNumZeroed(MaxChunks);
 }
 
+bool HScaleTypes::FHScaleSplitChunkBuffer::SetChunk(const uint8 Index, const uint8* Data, const uint32 Size)
+{
+	check(Index < MaxChunks)
+	if (!ensure(Size <= ChunkCapacity)) { return false; }
+
+	uint8* Slot = Buffer.data() + Index * SlotSize;
+	if (Slot[0] == Size && FMemory::Memcmp(Slot + 1, Data, Size) == 0) { return false; }
+
+	Slot[0] = Size;
+	FMemory::Memcpy(Slot + 1, Data, Size);
+	return true;
+}
+
+HScaleTypes::FHScaleSplitStringProperty::FHScaleSplitStringProperty(const uint8_t MaxLength)
+	: bIsPartial(false), MaxLength(MaxLength), Chunks(MaxLength), Count(0) {}
+
 void HScaleTypes::FHScaleSplitStringProperty::Serialize(TArray<FHScaleAttributesUpdate>& Attributes, const uint16 PropertyId)
 {
+	// string chunks carry no version, so the whole chain is sent, receiver would otherwise mix chunks of different writes
 	const uint16 Offset = FHScalePropertyIdConverters::GetSplitStringOffsetFromPropertyId(PropertyId, MaxLength);
 	for (uint8 i = 0; i < Count; i++)
 	{
-		SplitStrings[i]->Serialize(Attributes, Offset + i);
+		Attributes.Push({static_cast<uint16>(Offset + i), quark::value(reinterpret_cast<const char*>(Chunks.GetChunkData(i)), Chunks.GetChunkSize(i))});
 	}
 }
 
-void HScaleTypes::FHScaleSplitStringProperty::Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp)
-{
-	LastUpdatedTs = Timestamp;
-	Deserialize_R(CachedValue, PropertyId);
-}
-
 void HScaleTypes::FHScaleSplitStringProperty::Deserialize_R(const quark::value& CachedValue, const uint16 PropertyId)
 {
 	const uint8 Index = FHScalePropertyIdConverters::GetSplitPropertyIndexFromPropertyId(PropertyId, MaxLength);
+	if (Index >= MaxLength) { return; }
 
-	// if on receive, it is first partial update, then clear out all partial values held
+	// if on receive, it is first partial update, then forget all partial values held
 	if (!bIsPartial)
 	{
 		bIsPartial = true;
-		for (auto& PropertyPtr : SplitStrings)
-		{
-			FHScaleStringProperty* Property = CastPty<FHScaleStringProperty>(PropertyPtr.get());
-			Property->SetValue("");
-		}
+		Chunks.ClearReceived();
 		Count = 0;
 	}
 
-	// update the property value
-	SplitStrings[Index]->Deserialize(CachedValue, PropertyId, LastUpdatedTs);
-
-	const uint8 AssumptionCount = Index + 1;
-	Count = std::max(Count, AssumptionCount);
+	const quark::string SplitValue = CachedValue.as<quark::string>().value();
+	Chunks.SetChunk(Index, reinterpret_cast<const uint8*>(SplitValue.data()), std::min<size_t>(SplitValue.size(), FHScaleSplitChunkBuffer::ChunkCapacity));
+	Chunks.MarkReceived(Index);
+	Chunks.SetChunkTimestamp(Index, LastUpdatedTs);
 
-	// now check if all values are received and if so update FullString and bIsPartial
-	bool bIsValid = false;
-	for (uint8 i = 0; i < Count; i++)
+	// now check if chunks form a complete string and if so update FullString and bIsPartial
+	uint8 CompleteCount = 0;
+	for (uint8 i = 0; i < MaxLength; i++)
 	{
-		auto& PropertyPtr = SplitStrings[i];
-		const FHScaleStringProperty* Property = CastPty<FHScaleStringProperty>(PropertyPtr.get());
-		std::string SplitValue = Property->GetValue();
-		if (!FHScaleConversionUtils::IsValidSplitString(SplitValue)) { break; }
-		if (!FHScaleConversionUtils::IsHScaleSplitStringContd(SplitValue))
+		if (!Chunks.IsReceived(i) || Chunks.GetChunkSize(i) == 0) { break; }
+		const char Indicator = static_cast<char>(Chunks.GetChunkLastByte(i));
+		if (Indicator == '0')
 		{
-			bIsValid = true;
+			CompleteCount = i + 1;
 			break;
 		}
+		if (Indicator != '1') { break; }
 	}
 
-	if (bIsValid)
+	if (CompleteCount == 0)
 	{
-		// all partial updates are received, now update the FullString and bIsPartial
-		bIsPartial = false;
-		std::vector<std::string> Parts;
-		for (uint8 i = 0; i < Count; i++)
-		{
-			auto& PropertyPtr = SplitStrings[i];
-			const FHScaleStringProperty* Property = CastPty<FHScaleStringProperty>(PropertyPtr.get());
-			Parts.push_back(Property->GetValue());
-		}
-		FullStringValue = FHScaleConversionUtils::CombinePartStrings(Parts);
+		Count = std::max(Count, static_cast<uint8>(Index + 1));
+		return;
 	}
+
+	// all partial updates are received, now update the FullString and bIsPartial
+	bIsPartial = false;
+	Count = CompleteCount;
+	TArray<ANSICHAR, TInlineAllocator<HSCALE_MAX_STRING_LENGTH * HS_SPLIT_PROPERTY_MAX_LENGTH + 1>> Combined;
+	for (uint8 i = 0; i < Count; i++)
+	{
+		// the last character ('0' or '1') is the indicator
+		Combined.Append(reinterpret_cast<const ANSICHAR*>(Chunks.GetChunkData(i)), Chunks.GetChunkSize(i) - 1);
+	}
+	const FUTF8ToTCHAR Converted(Combined.GetData(), Combined.Num());
+	FullStringValue = FString(Converted.Length(), Converted.Get());
+}
+
+bool HScaleTypes::FHScaleSplitStringProperty::IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const
+{
+	const uint8 Index = FHScalePropertyIdConverters::GetSplitPropertyIndexFromPropertyId(PropertyId, MaxLength);
+	return Index < MaxLength && Chunks.GetChunkTimestamp(Index) > Timestamp;
 }
 
 bool HScaleTypes::FHScaleSplitStringProperty::SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd)
@@ -553,17 +567,28 @@ bool HScaleTypes::FHScaleSplitStringProperty::IsCompleteForReceive() const
 
 bool HScaleTypes::FHScaleSplitStringProperty::UpdateSplitStringFromFullString()
 {
-	std::vector<std::string> SplitValues;
-	FHScaleConversionUtils::SplitFStringToHScaleStrings(FullStringValue, SplitValues);
-	Count = SplitValues.size();
+	constexpr uint32 MaxSplitLength = HSCALE_MAX_STRING_LENGTH - 1;
+	const FTCHARToUTF8 Utf8String(*FullStringValue);
+	const uint8* Source = reinterpret_cast<const uint8*>(Utf8String.Get());
+	const uint32 TotalLength = Utf8String.Length();
 
-	check(Count <= MaxLength)
+	const uint8 PrevCount = Count;
+	const uint32 NumChunks = FMath::DivideAndRoundUp(TotalLength, MaxSplitLength);
+	check(NumChunks <= MaxLength)
+	Count = NumChunks;
 
+	uint8 Part[HSCALE_MAX_STRING_LENGTH];
 	for (uint8 i = 0; i < Count; ++i)
 	{
-		auto& PropertyPtr = SplitStrings[i];
-		FHScaleStringProperty* Property = CastPty<FHScaleStringProperty>(PropertyPtr.get());
-		Property->SetValue(SplitValues[i]);
+		const uint32 Start = i * MaxSplitLength;
+		const uint32 Length = std::min(MaxSplitLength, TotalLength - Start);
+		FMemory::Memcpy(Part, Source + Start, Length);
+		Part[Length] = Start + Length < TotalLength ? '1' : '0';
+		Chunks.SetChunk(i, Part, Length + 1);
+	}
+	for (uint8 i = Count; i < PrevCount; ++i)
+	{
+		Chunks.ClearChunk(i);
 	}
 
 	bIsPartial = false;
@@ -572,32 +597,29 @@ bool HScaleTypes::FHScaleSplitStringProperty::UpdateSplitStringFromFullString()
 }
 
 HScaleTypes::FHScaleSplitByteProperty::FHScaleSplitByteProperty(const uint8_t MaxLength)
-	: bIsPartial(false), MaxLength(MaxLength), Count(0)
-{
-	for (uint8 i = 0; i < MaxLength; ++i)
-	{
-		SplitBytes.push_back(std::move(CreateFromTypeId(EHScaleMemoryTypeId::Bytes)));
-	}
-}
+	: bIsPartial(false), MaxLength(MaxLength), Chunks(MaxLength), Count(0) {}
 
 void HScaleTypes::FHScaleSplitByteProperty::Serialize(TArray<FHScaleAttributesUpdate>& Attributes, uint16 PropertyId)
 {
 	const uint16 Offset = FHScalePropertyIdConverters::GetSplitBytesOffsetFromPropertyId(PropertyId, MaxLength);
-	for (uint8 i = 0; i < Count; i++)
-	{
-		SplitBytes[i]->Serialize(Attributes, Offset + i);
-	}
+	SerializeChunks(Attributes, Offset, true);
 }
 
-void HScaleTypes::FHScaleSplitByteProperty::Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp)
+void HScaleTypes::FHScaleSplitByteProperty::SerializeChunks(TArray<FHScaleAttributesUpdate>& Attributes, const uint16 Offset, const bool bOnlyDirty)
 {
-	LastUpdatedTs = Timestamp;
-	Deserialize_R(CachedValue, PropertyId);
+	for (uint8 i = 0; i < Count; i++)
+	{
+		if (bOnlyDirty && !Chunks.IsDirty(i)) { continue; }
+		Attributes.Push({static_cast<uint16>(Offset + i), quark::value(Chunks.GetChunkData(i), Chunks.GetChunkSize(i))});
+	}
+	Chunks.ClearDirty();
 }
 
 void HScaleTypes::FHScaleSplitByteProperty::DeserializeForIndex(const quark::value& Value, const uint16 PropertyId, const uint8 Index)
 {
-	quark::vector<uint8> Holder = Value.as<quark::vector<uint8>>().value();
+	if (Index >= MaxLength) { return; }
+
+	const quark::vector<uint8> Holder = Value.as<quark::vector<uint8>>().value();
 	const uint8 ReceivedHashId = FHScaleConversionUtils::FetchHashIdFromBuffer(Holder);
 
 	bool bIsReceivedHasIdValid = FHScaleConversionUtils::IsReceivedHasIdValid(OnReceiveHashID, ReceivedHashId);
@@ -605,33 +627,32 @@ void HScaleTypes::FHScaleSplitByteProperty::DeserializeForIndex(const quark::val
 	if (!bIsReceivedHasIdValid) { return; } // this signifies we received stale data, and we will not proceed with it
 
 	OnReceiveHashID = ReceivedHashId;
-	// if on receive, it is first partial update, then clear out all partial values held
+	// if on receive, it is first partial update, then forget all partial values held
+	// every re-split changes the hash id, so sender always sends all chunks of a split
 	if (!bIsPartial)
 	{
 		bIsPartial = true;
-		for (auto& PropertyPtr : SplitBytes)
-		{
-			FHScaleBytesProperty* Property = CastPty<FHScaleBytesProperty>(PropertyPtr.get());
-			Property->ClearBuffer();
-		}
+		Chunks.ClearReceived();
 		Count = 0;
 	}
 
-	SplitBytes[Index]->Deserialize(Value, PropertyId, LastUpdatedTs);
+	Chunks.SetChunk(Index, Holder.data(), std::min<size_t>(Holder.size(), FHScaleSplitChunkBuffer::ChunkCapacity));
+	Chunks.MarkReceived(Index);
+	Chunks.SetChunkTimestamp(Index, LastUpdatedTs);
 
 	const uint8 AssumptionCount = Index + 1;
 	Count = std::max(Count, AssumptionCount);
 
-	// now check if all values are received and if so update FullString and bIsPartial
+	// now check if all values are received and if so update FullBuffer and bIsPartial
 	bool bIsValid = false;
+	uint32 TotalLength = 0;
 	for (uint8 i = 0; i < Count; i++)
 	{
-		auto& PropertyPtr = SplitBytes[i];
-		FHScaleBytesProperty* Property = CastPty<FHScaleBytesProperty>(PropertyPtr.get());
-		std::vector<uint8>& SplitValue = Property->GetBuffer();
-		if (!FHScaleConversionUtils::IsValidSplitBuffer(SplitValue)) { break; }
-		if (!FHScaleConversionUtils::IsHScaleSplitBufferContd(SplitValue))
+		if (!Chunks.IsReceived(i) || Chunks.GetChunkSize(i) == 0) { break; }
+		TotalLength += Chunks.GetChunkSize(i) - 1;
+		if ((Chunks.GetChunkLastByte(i) & 1) == 0)
 		{
+			Count = i + 1;
 			bIsValid = true;
 			break;
 		}
@@ -639,24 +660,34 @@ void HScaleTypes::FHScaleSplitByteProperty::DeserializeForIndex(const quark::val
 
 	if (bIsValid)
 	{
-		// all partial updates are received, now update the FullString and bIsPartial
+		// all partial updates are received, now update the FullBuffer and bIsPartial
 		bIsPartial = false;
-		std::vector<std::vector<uint8>> Parts;
+		FullBuffer.resize(TotalLength);
+		uint8* Dest = FullBuffer.data();
 		for (uint8 i = 0; i < Count; i++)
 		{
-			auto& PropertyPtr = SplitBytes[i];
-			FHScaleBytesProperty* Property = CastPty<FHScaleBytesProperty>(PropertyPtr.get());
-			Parts.push_back(Property->GetBuffer());
+			// the last byte is the hash id and continuation indicator
+			const uint8 Length = Chunks.GetChunkSize(i) - 1;
+			FMemory::Memcpy(Dest, Chunks.GetChunkData(i), Length);
+			Dest += Length;
 		}
-		FHScaleConversionUtils::CombinePartBuffers(Parts, FullBuffer);
 	}
 }
 
 void HScaleTypes::FHScaleSplitByteProperty::Deserialize_R(const quark::value& Value, const uint16 PropertyId)
 {
-	const uint8 Index = FHScalePropertyIdConverters::GetSplitPropertyIndexFromPropertyId(PropertyId, MaxLength);
+	DeserializeForIndex(Value, PropertyId, GetChunkIndex(PropertyId));
+}
 
-	DeserializeForIndex(Value, PropertyId, Index);
+bool HScaleTypes::FHScaleSplitByteProperty::IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const
+{
+	const uint8 Index = GetChunkIndex(PropertyId);
+	return Index < MaxLength && Chunks.GetChunkTimestamp(Index) > Timestamp;
+}
+
+uint8 HScaleTypes::FHScaleSplitByteProperty::GetChunkIndex(const uint16 PropertyId) const
+{
+	return FHScalePropertyIdConverters::GetSplitPropertyIndexFromPropertyId(PropertyId, MaxLength);
 }
 
 bool HScaleTypes::FHScaleSplitByteProperty::SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd)
@@ -686,8 +717,7 @@ bool HScaleTypes::FHScaleSplitByteProperty::SerializeUE(FArchive& Ar, const FRep
 			// memcopy the writer data into byte buffer
 			if (Writer.GetNumBytes() > 0)
 			{
-				FullBuffer.assign(Writer.GetData(), Writer.GetData() + Writer.GetNumBytes());
-				bOutSuccess &= UpdateSplitBytesFromFullBytes();
+				SetFullBytes(Writer.GetData(), Writer.GetNumBytes());
 			}
 		}
 		else
@@ -717,8 +747,7 @@ bool HScaleTypes::FHScaleSplitByteProperty::SerializeUE(FArchive& Ar, const FRep
 			Holder.NetSerialize(Writer, nullptr, bOutSuccess);
 			if (Writer.GetNumBytes() > 0)
 			{
-				FullBuffer.assign(Writer.GetData(), Writer.GetData() + Writer.GetNumBytes());
-				bOutSuccess &= UpdateSplitBytesFromFullBytes();
+				SetFullBytes(Writer.GetData(), Writer.GetNumBytes());
 			}
 		}
 		else
@@ -749,20 +778,38 @@ bool HScaleTypes::FHScaleSplitByteProperty::IsCompleteForReceive() const
 	return IsValid() && !bIsPartial;
 }
 
+bool HScaleTypes::FHScaleSplitByteProperty::SetFullBytes(const uint8* Data, const int64 Num)
+{
+	if (static_cast<int64>(FullBuffer.size()) == Num && FMemory::Memcmp(FullBuffer.data(), Data, Num) == 0) { return false; }
+
+	FullBuffer.assign(Data, Data + Num);
+	return UpdateSplitBytesFromFullBytes();
+}
+
 bool HScaleTypes::FHScaleSplitByteProperty::UpdateSplitBytesFromFullBytes()
 {
-	std::vector<std::vector<uint8>> SplitBuffers;
+	constexpr uint32 MaxSplitLength = HSCALE_MAX_BUFFER_LENGTH - 1;
 	HashForSend = FHScaleConversionUtils::FetchNextHashIdForSend(HashForSend);
-	FHScaleConversionUtils::SplitBufferToHScaleBuffers(FullBuffer, SplitBuffers, HashForSend);
-	Count = SplitBuffers.size();
+	const uint32 TotalLength = FullBuffer.size();
 
-	check(Count <= MaxLength)
+	const uint8 PrevCount = Count;
+	const uint32 NumChunks = FMath::DivideAndRoundUp(TotalLength, MaxSplitLength);
+	check(NumChunks <= MaxLength)
+	Count = NumChunks;
 
+	uint8 Part[HSCALE_MAX_BUFFER_LENGTH];
 	for (uint8 i = 0; i < Count; ++i)
 	{
-		auto& PropertyPtr = SplitBytes[i];
-		FHScaleBytesProperty* Property = CastPty<FHScaleBytesProperty>(PropertyPtr.get());
-		Property->SetValue(SplitBuffers[i]);
+		const uint32 Start = i * MaxSplitLength;
+		const uint32 Length = std::min(MaxSplitLength, TotalLength - Start);
+		FMemory::Memcpy(Part, FullBuffer.data() + Start, Length);
+		// first bit of hash id signifies continuity
+		Part[Length] = static_cast<uint8>(Start + Length < TotalLength ? HashForSend | 1 : HashForSend & ~1);
+		if (Chunks.SetChunk(i, Part, Length + 1)) { Chunks.MarkDirty(i); }
+	}
+	for (uint8 i = Count; i < PrevCount; ++i)
+	{
+		Chunks.ClearChunk(i);
 	}
 	bIsPartial = false;
 
@@ -774,18 +821,13 @@ HScaleTypes::FHScaleObjectDataChunkProperty::FHScaleObjectDataChunkProperty()
 
 void HScaleTypes::FHScaleObjectDataChunkProperty::Serialize(TArray<FHScaleAttributesUpdate>& Attributes, const uint16 PropertyId)
 {
-	const uint16 Offset = PropertyId;
-	for (uint8 i = 0; i < Count; i++)
-	{
-		SplitBytes[i]->Serialize(Attributes, Offset + i);
-	}
+	// chunks of outer are always sent together, receiving outer drops partial chunks on every new update
+	SerializeChunks(Attributes, PropertyId, false);
 }
 
 void HScaleTypes::FHScaleObjectDataChunkProperty::Deserialize_R(const quark::value& Value, const uint16 PropertyId)
 {
-	const uint8 Index = FHScalePropertyIdConverters::GetOuterChunkPropertyIndexFromPropertyId(PropertyId);
-
-	DeserializeForIndex(Value, PropertyId, Index);
+	DeserializeForIndex(Value, PropertyId, GetChunkIndex(PropertyId));
 
 	if (!bIsPartial && FullBuffer.size() >= (sizeof(ExportFlags) + sizeof(NextValue)))
 	{
@@ -802,6 +844,11 @@ bool HScaleTypes::FHScaleObjectDataChunkProperty::SerializeUE(FArchive& Ar, cons
 	return false;
 }
 
+uint8 HScaleTypes::FHScaleObjectDataChunkProperty::GetChunkIndex(const uint16 PropertyId) const
+{
+	return FHScalePropertyIdConverters::GetOuterChunkPropertyIndexFromPropertyId(PropertyId);
+}
+
 
 void HScaleTypes::FHScaleObjectDataChunkProperty::SerializeChunk(FHScaleOuterChunk& Chunk, FHScaleOuterChunk* NextChunk, const uint8 CurIndex, const uint16 PropertyId)
 {
@@ -875,14 +922,9 @@ void HScaleTypes::FHScaleObjectDataProperty::Serialize(TArray<FHScaleAttributesU
 	}
 }
 
-void HScaleTypes::FHScaleObjectDataProperty::Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp)
-{
-	LastUpdatedTs = Timestamp;
-	Deserialize_R(CachedValue, PropertyId);
-}
-
 void HScaleTypes::FHScaleObjectDataProperty::Deserialize_R(const quark::value& Value, const uint16 PropertyId)
 {
+	ResolvedStaticObject.Reset();
 	if (Value.type() == quark::value_type::uint64)
 	{
 		DynamicProperty->Deserialize(Value, PropertyId, LastUpdatedTs);
@@ -928,6 +970,17 @@ void HScaleTypes::FHScaleObjectDataProperty::Deserialize_R(const quark::value& V
 	}
 }
 
+bool HScaleTypes::FHScaleObjectDataProperty::IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const
+{
+	const uint8 Index = FHScalePropertyIdConverters::GetOuterPropertyIndexFromPropertyId(PropertyId);
+	if (Index >= SplitChunks.size()) { return false; }
+	if (SplitChunks[Index]->IsStaleUpdate(PropertyId, Timestamp)) { return true; }
+
+	// dynamic guid is sent on the same attribute as the first chunk of the path
+	const bool bIsFirstChunk = Index == 0 && FHScalePropertyIdConverters::GetOuterChunkPropertyIndexFromPropertyId(PropertyId) == 0;
+	return bIsFirstChunk && DynamicProperty->IsStaleUpdate(PropertyId, Timestamp);
+}
+
 FString HScaleTypes::FHScaleObjectDataProperty::ToDebugString()
 {
 	return FString::Printf(TEXT("NetGUID= %s HScaleNetGUID=%s"), *NetworkGUID.ToString(), *HScaleNetGUID.ToString());
@@ -944,6 +997,7 @@ bool HScaleTypes::FHScaleObjectDataProperty::SerializeChunks(TArray<FHScaleOuter
 	NetworkGUID = NetGUID;
 	HScaleNetGUID = HSNetGUID;
 	bIsValid = true;
+	ResolvedStaticObject.Reset();
 
 	if (HScaleNetGUID.IsValid())
 	{
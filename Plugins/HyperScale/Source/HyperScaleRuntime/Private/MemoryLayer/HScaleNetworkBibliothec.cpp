@@ -49,16 +49,36 @@ void FHScaleNetworkBibliothec::AddNetworkEntity(const TSharedPtr<FHScaleNetworkE
 
 void FHScaleNetworkBibliothec::AddFlagsEntity(const FHScaleNetGUID& EntityId, uint16 Flags)
 {
+	bool bIsNewActorEntity = false;
 	uint16 Index = 0;
 	while (Flags > 0)
 	{
 		if (Flags & 1)
 		{
-			EntityPerFlags[Index].Add(EntityId);
+			bool bAlreadyFlagged = false;
+			EntityPerFlags[Index].Add(EntityId, &bAlreadyFlagged);
+			bIsNewActorEntity |= !bAlreadyFlagged && (1 << Index) == EHScaleEntityFlags::IsActor;
 		}
 		Flags >>= 1;
 		Index++;
 	}
+
+	// actor entities are flushed by relevancy manager when they stay out of relevancy for too long
+	if (bIsNewActorEntity && GetNetDriver())
+	{
+		const UHScaleConnection* Connection = GetNetDriver()->GetHyperScaleConnection();
+		UHScaleRelevancyManager* RelevancyManager = Connection ? Connection->GetRelevancyManager() : nullptr;
+		if (RelevancyManager)
+		{
+			RelevancyManager->TrackEntityDormancy(EntityId);
+		}
+	}
+
+	// position may arrive before the entity is known to be an actor
+	if (!ActorEntitiesGrid.Contains(EntityId))
+	{
+		UpdateEntityLocation(FindExistingEntity(EntityId).Get());
+	}
 }
 
 TSet<FHScaleNetGUID>::TConstIterator FHScaleNetworkBibliothec::FetchIteratorPerFlag(uint16 Flag) const
@@ -87,6 +107,7 @@ void FHScaleNetworkBibliothec::DestroyEntity(const FHScaleNetGUID& EntityId)
 	NetworkEntities.Remove(EntityId);
 	LocalDirtyEntities.Remove(EntityId);
 	ServerDirtyEntities.Remove(EntityId);
+	EntitiesPendingClassLoad.Remove(EntityId);
 
 	UHScaleConnection* Connection = GetNetDriver()->GetHyperScaleConnection();
 	check(Connection)
@@ -106,6 +127,7 @@ void FHScaleNetworkBibliothec::DestroyEntity(const FHScaleNetGUID& EntityId)
 	UHScalePackageMap* PkgMp = Cast<UHScalePackageMap>(Connection->PackageMap);
 
 	PkgMp->RemoveGUIDsFromMap(EntityId);
+	ActorEntitiesGrid.Remove(EntityId);
 	// Remove EntityId in EntityPerFlags
 	uint16 Flags = Entity->Flags;
 	uint16 Index = 0;
@@ -129,10 +151,27 @@ void FHScaleNetworkBibliothec::Push(FHScaleInBunch& Bunch, const FHScaleNetGUID
 	Entity->ChannelIndex = Bunch.Channel->ChIndex;
 	// update entity with new changes
 	Entity->Push(Bunch);
+	UpdateEntityLocation(Entity.Get());
 	// mark the entity as dirty
 	Entity->MarkEntityLocalDirty();
 }
 
+void FHScaleNetworkBibliothec::UpdateEntityLocation(const FHScaleNetworkEntity* Entity)
+{
+	if (!Entity || !Entity->IsActor()) return;
+
+	FVector Location;
+	if (Entity->GetEntityLocation(Location))
+	{
+		ActorEntitiesGrid.Update(Entity->EntityId, Location);
+	}
+}
+
+void FHScaleNetworkBibliothec::QueryActorEntitiesInRadius(const FVector& Center, const float Radius, TArray<FHScaleNetGUID>& OutEntities) const
+{
+	ActorEntitiesGrid.Query(Center, Radius, OutEntities);
+}
+
 void FHScaleNetworkBibliothec::PullAndClearLocalPlayerChanges(TArray<FHScaleLocalUpdate>& LocalUpdates)
 {
 	if (!LocalPlayerEntity.IsValid())
@@ -143,33 +182,42 @@ void FHScaleNetworkBibliothec::PullAndClearLocalPlayerChanges(TArray<FHScaleLoca
 
 	// if (LocalPlayerEntity->NumLocalDirtyProps() == 0) { return; }
 
-	// #todo: Instead of sending it always, optimize it by checking last position. This would go away, once centroid delegates are implemented
-	// Send position
+	// #todo: This would go away, once centroid delegates are implemented
+	// Send position, only when it moved noticeably since the last sent one
 	const UHScaleNetDriver* Driver = GetNetDriver();
 	check(Driver)
 	FVector Location;
 	FRotator Rotation;
 	Driver->GetPlayerViewPoint(Location, Rotation);
+
 	FHScaleLocalUpdate PlayerUpdate;
 	PlayerUpdate.bIsPlayer = true;
-	PlayerUpdate.Attributes.Add({QUARK_KNOWN_ATTRIBUTE_POSITION, quark::vec3(Location.X, Location.Y, Location.Z)});
+	if (!LastSentPlayerLocation.IsSet() || FVector::DistSquared(LastSentPlayerLocation.GetValue(), Location) >= FMath::Square(HSCALE_PLAYER_POSITION_SEND_THRESHOLD))
+	{
+		PlayerUpdate.Attributes.Add({QUARK_KNOWN_ATTRIBUTE_POSITION, quark::vec3(Location.X, Location.Y, Location.Z)});
+		LastSentPlayerLocation = Location;
+	}
 	LocalPlayerEntity->Pull(PlayerUpdate.Attributes);
-
-	LocalUpdates.Add(PlayerUpdate);
 	LocalPlayerEntity->ClearLocalDirtyProps();
+
+	if (PlayerUpdate.Attributes.IsEmpty()) { return; }
+
+	LocalUpdates.Add(MoveTemp(PlayerUpdate));
 }
 
 void FHScaleNetworkBibliothec::PullAndClearLocalEntityChanges(TArray<FHScaleLocalUpdate>& LocalUpdates)
 {
-	const int DirtyEntitiesCount = LocalDirtyEntities.Num();
-	if (DirtyEntitiesCount == 0)
+	if (LocalDirtyEntities.IsEmpty())
 	{
 		return;
 	}
 
-	TSet<TSharedPtr<FHScaleNetworkEntity>> DirtySet;
-	// Filter out stale objects, unreferenced objects
-	for (const auto ObjectId : LocalDirtyEntities)
+	// Swap the dirty set with the empty back buffer and walk it in place,
+	// entities that can't be sent yet are put back to the dirty set for next tick
+	Swap(LocalDirtyEntities, PulledLocalDirtyEntities);
+	LocalUpdates.Reserve(LocalUpdates.Num() + PulledLocalDirtyEntities.Num());
+
+	for (const FHScaleNetGUID ObjectId : PulledLocalDirtyEntities)
 	{
 		const TSharedPtr<FHScaleNetworkEntity>* CachedEntity = NetworkEntities.Find(ObjectId);
 		if (CachedEntity == nullptr or !CachedEntity->IsValid())
@@ -177,30 +225,25 @@ void FHScaleNetworkBibliothec::PullAndClearLocalEntityChanges(TArray<FHScaleLoca
 			UE_LOG(Log_HyperScaleMemory, Warning, TEXT("ObjectId %llu is marked local dirty, but object is not present"), ObjectId.Get());
 			continue;
 		}
-		TSharedPtr<FHScaleNetworkEntity> Entity = *CachedEntity;
-		UE_CLOG(!Entity->IsReadyForReplication(), Log_HyperScaleMemory, Verbose, TEXT("Entity %llu is not ready for replication"), ObjectId.Get())
-		if (Entity->NumLocalDirtyProps() == 0 || !Entity->IsReadyForReplication()) { continue; }
-		DirtySet.Add(Entity);
-	}
 
-	const int ActualDirtyCount = DirtySet.Num();
-	if (ActualDirtyCount == 0)
-	{
-		return;
-	}
+		FHScaleNetworkEntity* Entity = CachedEntity->Get();
+		UE_CLOG(!Entity->IsReadyForReplication(), Log_HyperScaleMemory, Verbose, TEXT("Entity %llu is not ready for replication"), ObjectId.Get())
+		if (Entity->NumLocalDirtyProps() == 0 || !Entity->IsReadyForReplication())
+		{
+			LocalDirtyEntities.Add(ObjectId);
+			continue;
+		}
 
-	for (const auto Entity : DirtySet)
-	{
-		const FHScaleNetGUID ObjectId = Entity->EntityId;
-		FHScaleLocalUpdate Update;
+		FHScaleLocalUpdate& Update = LocalUpdates.AddDefaulted_GetRef();
 		Update.bIsPlayer = false;
 		Update.ObjectId = ObjectId.Get();
 		Entity->Pull(Update.Attributes);
-		LocalUpdates.Push(Update);
 		// Once attributes are pulled clear properties marked as dirty
 		Entity->ClearLocalDirtyProps();
-		LocalDirtyEntities.Remove(ObjectId);
 	}
+
+	// Keeps allocation for the next swap
+	PulledLocalDirtyEntities.Reset();
 }
 
 bool FHScaleNetworkBibliothec::Pull(FInBunch& Bunch, const FHScaleNetGUID ObjectId, const bool bDelta)
@@ -303,6 +346,30 @@ bool FHScaleNetworkBibliothec::IsEntityExists(const FHScaleNetGUID ObjectId) con
 	return NetworkEntities.Contains(ObjectId);
 }
 
+void FHScaleNetworkBibliothec::AddEntityPendingClassLoad(const FHScaleNetGUID& EntityId)
+{
+	EntitiesPendingClassLoad.Add(EntityId);
+}
+
+void FHScaleNetworkBibliothec::ResolvePendingClassLoads()
+{
+	for (TSet<FHScaleNetGUID>::TIterator It = EntitiesPendingClassLoad.CreateIterator(); It; ++It)
+	{
+		const TSharedPtr<FHScaleNetworkEntity> Entity = FindExistingEntity(*It);
+		if (!Entity.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Entity->RetryPendingClassLoad())
+		{
+			Entity->MarkEntityServerDirty();
+			It.RemoveCurrent();
+		}
+	}
+}
+
 void FHScaleNetworkBibliothec::ClearServerDirtyEntities()
 {
 	ServerDirtyEntities.Empty();
@@ -331,38 +398,49 @@ void FHScaleNetworkBibliothec::SetPlayerClassId(const uint64 ClassId)
 	PlayerClassId = ClassId;
 }
 
-void FHScaleNetworkBibliothec::HandlePlayersNetworkUpdate(const quark::remote_player_update& Update)
+void FHScaleNetworkBibliothec::HandlePlayersNetworkUpdate(const quark_player_id_t RemotePlayerId, const quark_attribute_id_t AttributeId, const quark::value& Value, const quark_timestamp_t Timestamp)
 {
-	const PlayerId CurrentPlayerId = Update.player_id();
-	if (CurrentPlayerId == LocalPlayerEntity->EntityId.Get())
+	if (RemotePlayerId == LocalPlayerEntity->EntityId.Get())
 	{
 		UE_LOG(Log_HyperScaleMemory, Warning, TEXT("On receive, no handling of local player, skipping"))
 		return;
 	}
-	const FHScaleNetGUID TempPlayerId = FHScaleNetGUID::Create_Player(CurrentPlayerId);
+	const FHScaleNetGUID TempPlayerId = FHScaleNetGUID::Create_Player(RemotePlayerId);
 	const TSharedPtr<FHScaleNetworkEntity> Entity = FetchEntity(TempPlayerId);
-	Entity->Push(Update.attribute_id(), Update.value(), Update.timestamp());
+	if (!Entity->Push(AttributeId, Value, Timestamp))
+	{
+		++DroppedStaleUpdates;
+		return;
+	}
+	if (AttributeId == QUARK_KNOWN_ATTRIBUTE_POSITION)
+	{
+		UpdateEntityLocation(Entity.Get());
+	}
 	Entity->MarkEntityServerDirty();
 }
 
-void FHScaleNetworkBibliothec::HandleObjectsNetworkUpdate(const quark::remote_object_update& Update)
+void FHScaleNetworkBibliothec::HandleObjectsNetworkUpdate(const quark_object_id_t RemoteObjectId, const quark_attribute_id_t AttributeId, const quark::value& Value, const quark_timestamp_t Timestamp)
 {
-	const ObjectId ObjectId = Update.object_id();
-
-	const uint32 SessionId = GetNetDriver()->GetHyperScaleConnection()->GetSessionId();
-
-	const FHScaleNetGUID TempObjectId = FHScaleNetGUID::Create_Object(ObjectId);
+	const FHScaleNetGUID TempObjectId = FHScaleNetGUID::Create_Object(RemoteObjectId);
 
 	const TSharedPtr<FHScaleNetworkEntity> Entity = FetchEntity(TempObjectId);
 
 	// // #todo: replace with proper roles later
-	// if (FHScaleStatics::IsPlayerOwnedObject(ObjectId, SessionId))
+	// if (FHScaleStatics::IsPlayerOwnedObject(RemoteObjectId, SessionId))
 	// {
-	// 	Entity->PushPlayerOwnedUpdate(Update.attribute_id(), Update.value(), Update.timestamp());
+	// 	Entity->PushPlayerOwnedUpdate(AttributeId, Value, Timestamp);
 	// 	return;
 	// }
 
-	Entity->Push(Update.attribute_id(), Update.value(), Update.timestamp());
+	if (!Entity->Push(AttributeId, Value, Timestamp))
+	{
+		++DroppedStaleUpdates;
+		return;
+	}
+	if (AttributeId == QUARK_KNOWN_ATTRIBUTE_POSITION)
+	{
+		UpdateEntityLocation(Entity.Get());
+	}
 
 	Entity->MarkEntityServerDirty();
 }
\ No newline at end of file
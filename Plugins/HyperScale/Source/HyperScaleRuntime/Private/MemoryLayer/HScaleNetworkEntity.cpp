@@ -2,6 +2,7 @@
 
 #include "MemoryLayer/HScaleNetworkEntity.h"
 
+#include "BookKeeper/HSClassTranslator.h"
 #include "Core/HScaleResources.h"
 #include "Engine/ActorChannel.h"
 #include "MemoryLayer/HScaleNetworkBibliothec.h"
@@ -12,6 +13,7 @@
 #include "NetworkLayer/HScalePackageMap.h"
 #include "ReplicationLayer/HScaleActorChannel.h"
 #include "Utils/CommonAdapters.h"
+#include "Utils/HScaleBitWriterPool.h"
 #include "Utils/HScaleObjectSerializationHelpers.h"
 #include "Utils/HScaleStatics.h"
 
@@ -36,57 +38,57 @@ TSharedPtr<FHScaleNetworkEntity> FHScaleNetworkEntity::Create(const FHScaleNetGU
 FHScaleProperty* FHScaleNetworkEntity::FetchPropertyOnReceive(const uint16 PropertyId, const quark::value& CachedValue)
 {
 	const uint16 EqPropertyId = FHScalePropertyIdConverters::GetEquivalentPropertyId(PropertyId);
-	// Check if the key exists in the map
-	if (!Properties.contains(EqPropertyId))
+	// Fetch or insert the slot with a single lookup
+	std::unique_ptr<FHScaleProperty>& Property = Properties[EqPropertyId];
+	if (!Property)
 	{
 		EHScaleMemoryTypeId MemoryTypeId = FHScalePropertyIdConverters::FetchMemoryTypeIdForPropertyIdOnReceive(PropertyId, CachedValue.type());
 		// Key not found, create a new entry
-		Properties[EqPropertyId] = std::move(FHScaleProperty::CreateFromTypeId(MemoryTypeId));
+		Property = std::move(FHScaleProperty::CreateFromTypeId(MemoryTypeId));
 	}
 
-	const auto& Property = Properties.find(EqPropertyId);
-	return Property->second.get();
+	return Property.get();
 }
 
 FHScaleProperty* FHScaleNetworkEntity::FetchApplicationProperty(const uint16 PropertyId, const FRepLayoutCmd& Cmd)
 {
-	// Check if the key exists in the map
-	if (!Properties.contains(PropertyId))
+	// Fetch or insert the slot with a single lookup
+	std::unique_ptr<FHScaleProperty>& Property = Properties[PropertyId];
+	if (!Property)
 	{
 		// Key not found, create a new entry
-		Properties[PropertyId] = std::move(FHScaleProperty::CreateFromCmd(Cmd));
+		Property = std::move(FHScaleProperty::CreateFromCmd(Cmd));
 	}
 
-	const auto& Property = Properties.find(PropertyId);
-	return Property->second.get();
+	return Property.get();
 }
 
 FHScaleProperty* FHScaleNetworkEntity::FetchApplicationProperty(const uint16 PropertyId, const EHScaleMemoryTypeId TypeId)
 {
-	// Check if the key exists in the map
-	if (!Properties.contains(PropertyId))
+	// Fetch or insert the slot with a single lookup
+	std::unique_ptr<FHScaleProperty>& Property = Properties[PropertyId];
+	if (!Property)
 	{
 		// Key not found, create a new entry
-		Properties[PropertyId] = std::move(FHScaleProperty::CreateFromTypeId(TypeId));
+		Property = std::move(FHScaleProperty::CreateFromTypeId(TypeId));
 	}
 
-	const auto& Property = Properties.find(PropertyId);
-	return Property->second.get();
+	return Property.get();
 }
 
 FHScaleProperty* FHScaleNetworkEntity::FetchNonApplicationProperty(const uint16 PropertyId)
 {
 	const uint16 EqPropertyId = FHScalePropertyIdConverters::GetEquivalentPropertyId(PropertyId);
-	// Check if the key exists in the map
-	if (!Properties.contains(EqPropertyId))
+	// Fetch or insert the slot with a single lookup
+	std::unique_ptr<FHScaleProperty>& Property = Properties[EqPropertyId];
+	if (!Property)
 	{
 		const EHScaleMemoryTypeId MemoryTypeId = FHScalePropertyIdConverters::FetchNonApplicationMemoryTypeIdFromPropertyId(PropertyId);
 		// Key not found, create a new entry
-		Properties[EqPropertyId] = std::move(FHScaleProperty::CreateFromTypeId(MemoryTypeId));
+		Property = std::move(FHScaleProperty::CreateFromTypeId(MemoryTypeId));
 	}
 
-	const auto& Property = Properties.find(EqPropertyId);
-	return Property->second.get();
+	return Property.get();
 }
 
 bool FHScaleNetworkEntity::IsDynArrayEntity() const
@@ -356,16 +358,22 @@ FHScaleNetworkEntity* FHScaleNetworkEntity::GetChannelOwner()
 	return nullptr;
 }
 
-void FHScaleNetworkEntity::Push(const uint16_t PropertyId, const quark::value& Value, const uint64 Timestamp)
+bool FHScaleNetworkEntity::Push(const uint16_t PropertyId, const quark::value& Value, const uint64 Timestamp)
 {
 	if (Value.type() == quark::value_type::none)
 	{
 		DeleteProperty(PropertyId);
-		return;
+		return true;
 	}
 
 	FHScaleProperty* Property = FetchPropertyOnReceive(PropertyId, Value);
-	Property->Deserialize(Value, PropertyId, Timestamp);
+	if (!Property->Deserialize(Value, PropertyId, Timestamp))
+	{
+		++DroppedStaleUpdates;
+		UE_LOG(Log_HyperScaleMemory, VeryVerbose, TEXT("Dropped stale update of property %d on entity %llu, timestamp %llu older than %llu"),
+			PropertyId, EntityId.Get(), Timestamp, Property->LastUpdatedTs)
+		return false;
+	}
 
 	if (FHScalePropertyIdConverters::IsReservedProperty(PropertyId)) // Reserved properties are for plugin usage, they are by default not included as dirty props
 	{
@@ -392,6 +400,7 @@ void FHScaleNetworkEntity::Push(const uint16_t PropertyId, const quark::value& V
 			}
 		}
 	}
+	return true;
 }
 
 
@@ -421,9 +430,24 @@ void FHScaleNetworkEntity::HandleObjectPathUpdate(HScaleTypes::FHScaleObjectData
 void FHScaleNetworkEntity::HandleArchetypeUpdate(HScaleTypes::FHScaleObjectDataProperty* Property)
 {
 	if (!Property->IsCompleteForReceive()) return;
+
+	const bool bWasPending = !PendingClassPackage.IsEmpty();
+	PendingClassPackage.Reset();
+
 	UObject* Object = nullptr;
-	LoadObjectPtrData(Property, Object);
-	if (Object)
+	FString MissingPackage;
+	LoadObjectPtrData(Property, Object, &MissingPackage);
+	if (!Object && !MissingPackage.IsEmpty() && FHSClassTranslator::GetInstance().RequestPackageAsync(MissingPackage))
+	{
+		// initialization (and so the spawn) is deferred, the package is not loaded synchronously on game thread
+		PendingClassPackage = MissingPackage;
+		if (!bWasPending)
+		{
+			GetBibliothec()->AddEntityPendingClassLoad(EntityId);
+		}
+		UE_LOG(Log_HyperScaleMemory, Verbose, TEXT("EntityId %llu waits for async load of package %s"), EntityId.Get(), *MissingPackage)
+	}
+	else if (Object)
 	{
 		if (Object->IsA<UClass>())
 		{
@@ -461,8 +485,15 @@ void FHScaleNetworkEntity::LoadStaticComponent()
 	}
 }
 
-void FHScaleNetworkEntity::LoadObjectPtrData(HScaleTypes::FHScaleObjectDataProperty* Property, UObject*& Object) const
+void FHScaleNetworkEntity::LoadObjectPtrData(HScaleTypes::FHScaleObjectDataProperty* Property, UObject*& Object, FString* OutMissingPackage) const
 {
+	// static references do not change their object until property changes, no need to rebuild the path
+	if (UObject* ResolvedObject = Property->ResolvedStaticObject.Get())
+	{
+		Object = ResolvedObject;
+		return;
+	}
+
 	TArray<FHScaleOuterChunk> Chunks;
 	Property->DeserializeChunks(Chunks);
 
@@ -474,8 +505,14 @@ void FHScaleNetworkEntity::LoadObjectPtrData(HScaleTypes::FHScaleObjectDataPrope
 	UHScalePackageMap* PkgMap = Cast<UHScalePackageMap>(GetNetConnection()->PackageMap);
 	check(PkgMap)
 	
-	FHScaleObjectSerializationHelper::LoadObject(Object, Chunks, NetGUID, PkgMap);
+	FHScaleObjectSerializationHelper::LoadObject(Object, Chunks, NetGUID, PkgMap, OutMissingPackage);
 	Property->NetworkGUID = NetGUID;
+
+	const bool bHasDynamicOuter = Chunks.ContainsByPredicate([](const FHScaleOuterChunk& Chunk) { return Chunk.HS_NetGUID.IsValid(); });
+	if (Object && NetGUID.IsValid() && !bHasDynamicOuter)
+	{
+		Property->ResolvedStaticObject = Object;
+	}
 }
 
 bool FHScaleNetworkEntity::IsHeadersValid() const
@@ -513,6 +550,8 @@ bool FHScaleNetworkEntity::IsHeadersValid() const
 
 		HScaleTypes::FHScaleObjectDataProperty* Property = CastPty<HScaleTypes::FHScaleObjectDataProperty>(FindExistingProperty(HS_RESERVED_OBJECT_ARCHETYPE_ATTRIBUTE_ID));
 		if (!Property->IsValid()) return false;
+
+		if (!PendingClassPackage.IsEmpty()) return false;
 	}
 
 	if (Flags & EHScaleEntityFlags::IsComponent)
@@ -595,6 +634,25 @@ void FHScaleNetworkEntity::CheckAndReviseStates()
 	}
 }
 
+bool FHScaleNetworkEntity::RetryPendingClassLoad()
+{
+	if (PendingClassPackage.IsEmpty()) return true;
+	if (FHSClassTranslator::GetInstance().IsPackageLoading(PendingClassPackage)) return false;
+
+	HScaleTypes::FHScaleObjectDataProperty* Property = CastPty<HScaleTypes::FHScaleObjectDataProperty>(FindExistingProperty(HS_RESERVED_OBJECT_ARCHETYPE_ATTRIBUTE_ID));
+	if (Property)
+	{
+		HandleArchetypeUpdate(Property);
+	}
+	else
+	{
+		PendingClassPackage.Reset();
+	}
+
+	CheckAndReviseStates();
+	return PendingClassPackage.IsEmpty();
+}
+
 void FHScaleNetworkEntity::PrintHeaders() const
 {
 	UE_LOG(Log_HyperScaleMemory, Verbose, TEXT("IsActor:%d IsComponent:%d IsArchetype:%d IsFullObjectPath:%d IsStaticComponent:%d"), Flags&EHScaleEntityFlags::IsActor, Flags&EHScaleEntityFlags::IsComponent, Flags&EHScaleEntityFlags::HasArchetypeData, Flags&EHScaleEntityFlags::HasObjectPath, Flags&EHScaleEntityFlags::IsStaticComponent)
@@ -667,19 +725,12 @@ void FHScaleNetworkEntity::PrintHeaders() const
 
 uint16 FHScaleRepCmdIterator::FetchCmdIndex(const uint16 PropertyHandle)
 {
-	const uint16 ExpectedIndex = PropertyHandle - 1;
-	CurIndex = FMath::Max(CurIndex, ExpectedIndex);
-	while (CurIndex < Cmds->Num())
-	{
-		const FRepLayoutCmd& Cmd = (*Cmds)[CurIndex];
-		if (Cmd.RelativeHandle == PropertyHandle)
-		{
-			return CurIndex;
-		}
-		CurIndex++;
-	}
+	if (!HandleToCmdIndex->IsValidIndex(PropertyHandle)) { return UINT16_MAX; }
 
-	return UINT16_MAX;
+	// table covers top level handles only, inner cmds of dynamic arrays are left out on purpose (see UHScaleNetDriver::GetHandleToCmdIndexTable)
+	// array element cmds are reached by FetchNextIndex from the array cmd set here
+	CurIndex = (*HandleToCmdIndex)[PropertyHandle];
+	return CurIndex;
 }
 
 uint16 FHScaleRepCmdIterator::FetchNextIndex()
@@ -740,15 +791,30 @@ void FHScaleNetworkEntity::WriteOutSoftObject(FHScaleProperty* Property, FBitWri
 	}
 }
 
+const FHScaleNetworkEntity::FHScaleCachedRepLayout& FHScaleNetworkEntity::FetchCachedRepLayout(UClass* ObjectClass) const
+{
+	if (CachedRepLayout.RepLayout.IsValid() && CachedRepLayout.ClassId == ClassId && CachedRepLayout.Class.Get() == ObjectClass)
+	{
+		return CachedRepLayout;
+	}
+
+	UHScaleNetDriver* Driver = GetNetDriver();
+	check(Driver)
+	CachedRepLayout.ClassId = ClassId;
+	CachedRepLayout.Class = ObjectClass;
+	CachedRepLayout.RepLayout = Driver->GetObjectClassRepLayout_Copy(ObjectClass);
+	CachedRepLayout.HandleToCmdIndex = &Driver->GetHandleToCmdIndexTable(ObjectClass, *CachedRepLayout.RepLayout);
+	return CachedRepLayout;
+}
+
 void FHScaleNetworkEntity::WriteProperties_R(THScaleUSetSMapIterator<uint16, std::unique_ptr<FHScaleProperty>>& It, FBitWriter& Writer, UClass* ObjectClass) const
 {
 	Writer.WriteBit(0); // bEnablePropertyChecksum
 	check(ObjectClass)
-	UHScaleNetDriver* Driver = GetNetDriver();
-	const TSharedPtr<FRepLayout> RepLayout = Driver->GetObjectClassRepLayout_Copy(ObjectClass);
-	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, RepLayout.Get(), Cmds);
+	const FHScaleCachedRepLayout& Layout = FetchCachedRepLayout(ObjectClass);
+	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, Layout.RepLayout.Get(), Cmds);
 
-	FHScaleRepCmdIterator CmdIterator(&Cmds);
+	FHScaleRepCmdIterator CmdIterator(&Cmds, Layout.HandleToCmdIndex);
 	for (; !It.IsEnd(); ++It)
 	{
 		const uint16 PropertyId = *It;
@@ -815,9 +881,9 @@ void FHScaleNetworkEntity::WriteOutObjPtrData(FHScaleProperty* Property, FBitWri
 FHScaleProperty* FHScaleNetworkEntity::SwitchPropertyWithNewType(const uint16 PropertyId, EHScaleMemoryTypeId NewMemoryTypeId)
 {
 	DeleteProperty(PropertyId);
-	Properties[PropertyId] = std::move(FHScaleProperty::CreateFromTypeId(NewMemoryTypeId));
-	const auto& Property = Properties.find(PropertyId);
-	return Property->second.get();
+	std::unique_ptr<FHScaleProperty>& Property = Properties[PropertyId];
+	Property = std::move(FHScaleProperty::CreateFromTypeId(NewMemoryTypeId));
+	return Property.get();
 }
 
 bool FHScaleNetworkEntity::ReadSoftObjectFromBunch(FBitReader& Bunch, FHScaleProperty*& Property, uint16 PropertyId)
@@ -966,7 +1032,8 @@ bool FHScaleNetworkEntity::PullComponentData(FBitWriter& Writer, bool bIncludeSp
 			Writer << ExportFlags.Value;
 		}
 	}
-	FBitWriter RepProperties(16384);
+	FHScaleScopedBitWriter ScopedRepProperties(16384);
+	FBitWriter& RepProperties = *ScopedRepProperties;
 	// RepProperties.SetEngineNetVer(Bunch.EngineNetVer());
 	UClass* ObjectClass = FetchEntityUClass();
 
@@ -1003,7 +1070,8 @@ bool FHScaleNetworkEntity::PullData(FInBunch& Bunch, const bool bIncludeSpawnInf
 
 	bool bResult = true;
 
-	FBitWriter Writer(49152);
+	FHScaleScopedBitWriter ScopedWriter(49152);
+	FBitWriter& Writer = *ScopedWriter;
 	// Writer.SetEngineNetVer(Bunch.EngineNetVer());
 	FHScaleNetGUID GUID = EntityId;
 
@@ -1044,7 +1112,8 @@ bool FHScaleNetworkEntity::PullData(FInBunch& Bunch, const bool bIncludeSpawnInf
 	Writer.WriteBit(1); // bHasRepLayout
 	Writer.WriteBit(1); // bIsActor
 
-	FBitWriter RepProperties(40960);
+	FHScaleScopedBitWriter ScopedRepProperties(40960);
+	FBitWriter& RepProperties = *ScopedRepProperties;
 	UClass* ObjectClass = FetchEntityUClass();
 
 	bool bClearServerDirty = true;
@@ -1282,7 +1351,8 @@ void FHScaleNetworkEntity::ReadSubObjectPtrChunks(TArray<FHScaleOuterChunk>& Out
 	Chunk.NetGUID = NetGUID;
 	Chunk.ObjectName = Object->GetName();
 
-	FBitWriter Writer(8192);
+	FHScaleScopedBitWriter ScopedWriter(8192);
+	FBitWriter& Writer = *ScopedWriter;
 	UObject* Outer = Object->GetOuter();
 	FNetworkGUID OuterNetGUID;
 	PkgMap->SerializeObject(Writer, UObject::StaticClass(), Outer, &OuterNetGUID);
@@ -1428,21 +1498,13 @@ void FHScaleNetworkEntity::ReadComponentsData(FHScaleInBunch& Bunch, UHScaleActo
 	else { ReadSubObjectDeleteUpdate(Bunch, Channel); }
 }
 
-void FHScaleNetworkEntity::CheckAndUpdateOwner(const TArray<FRepParentCmd>& ParentCmds, const FRepLayoutCmd& RepCmd, FHScaleProperty* Property)
+void FHScaleNetworkEntity::UpdateOwnerFromProperty(FHScaleProperty* Property)
 {
-	const uint16 ParentIndex = RepCmd.ParentIndex;
-	const FRepParentCmd Parent = ParentCmds[ParentIndex];
-
-	const FString ParentPropertyName = Parent.Property->GetName();
-	const bool bIsChildProperty = ParentPropertyName != RepCmd.Property->GetName();
-	if (RepCmd.Property->GetName() == TEXT("Owner") && !bIsChildProperty && FHScaleStatics::IsObjectDataRepCmd(RepCmd))
+	const HScaleTypes::FHScaleObjectDataProperty* R_OwnerProperty = CastPty<HScaleTypes::FHScaleObjectDataProperty>(Property);
+	check(R_OwnerProperty)
+	if (R_OwnerProperty->HScaleNetGUID.IsObject())
 	{
-		const HScaleTypes::FHScaleObjectDataProperty* R_OwnerProperty = CastPty<HScaleTypes::FHScaleObjectDataProperty>(Property);
-		check(R_OwnerProperty)
-		if (R_OwnerProperty->HScaleNetGUID.IsObject())
-		{
-			UpdateOwner(R_OwnerProperty->HScaleNetGUID);
-		}
+		UpdateOwner(R_OwnerProperty->HScaleNetGUID);
 	}
 }
 
@@ -1451,11 +1513,12 @@ void FHScaleNetworkEntity::ReadProperties_R(FBitReader& Bunch, const TSharedPtr<
 	check(ActorReplicator.IsValid())
 	// payload contains series of property handles(packed int) and property data
 	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, ActorReplicator->RepLayout.Get(), Cmds);
-	const TArray<FRepParentCmd>& ParentCmds = HSCALE_GET_PRIVATE(FRepLayout, ActorReplicator->RepLayout.Get(), Parents);
+	check(GetNetDriver())
+	const int32 OwnerCmdIndex = GetNetDriver()->GetOwnerCmdIndex(ActorReplicator->ObjectClass, *ActorReplicator->RepLayout);
 
 	uint32 PropertyHandle;
 	Bunch.SerializeIntPacked(PropertyHandle);
-	FHScaleRepCmdIterator CmdIterator(&Cmds);
+	FHScaleRepCmdIterator CmdIterator(&Cmds, &GetNetDriver()->GetHandleToCmdIndexTable(ActorReplicator->ObjectClass, *ActorReplicator->RepLayout));
 	while (0 != PropertyHandle) // if we reach end, property handle would be 0
 	{
 		// Property handles are 16bit unsigned values, they are packed as 32 bit
@@ -1491,7 +1554,7 @@ void FHScaleNetworkEntity::ReadProperties_R(FBitReader& Bunch, const TSharedPtr<
 		if (bIsChanged) { AddLocalDirtyProperty(PropertyId); }
 
 		// see if owner is changed, and update owner
-		CheckAndUpdateOwner(ParentCmds, RepCmd, Property);
+		if (CmdIndex == OwnerCmdIndex) { UpdateOwnerFromProperty(Property); }
 
 		// read next property handle
 		Bunch.SerializeIntPacked(PropertyHandle);
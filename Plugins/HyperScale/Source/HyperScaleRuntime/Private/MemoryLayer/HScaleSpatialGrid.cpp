@@ -0,0 +1,78 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+
+#include "MemoryLayer/HScaleSpatialGrid.h"
+
+void FHScaleSpatialGrid::Update(const FHScaleNetGUID& EntityId, const FVector& Location)
+{
+	const FIntVector NewCell = GetCell(Location);
+
+	if (FIntVector* CurrentCell = EntityCells.Find(EntityId))
+	{
+		if (*CurrentCell == NewCell) return;
+
+		TSet<FHScaleNetGUID>& OldBucket = Cells.FindChecked(*CurrentCell);
+		OldBucket.Remove(EntityId);
+		if (OldBucket.IsEmpty())
+		{
+			Cells.Remove(*CurrentCell);
+		}
+		*CurrentCell = NewCell;
+	}
+	else
+	{
+		EntityCells.Add(EntityId, NewCell);
+	}
+
+	Cells.FindOrAdd(NewCell).Add(EntityId);
+}
+
+void FHScaleSpatialGrid::Remove(const FHScaleNetGUID& EntityId)
+{
+	FIntVector Cell;
+	if (!EntityCells.RemoveAndCopyValue(EntityId, Cell)) return;
+
+	TSet<FHScaleNetGUID>& Bucket = Cells.FindChecked(Cell);
+	Bucket.Remove(EntityId);
+	if (Bucket.IsEmpty())
+	{
+		Cells.Remove(Cell);
+	}
+}
+
+void FHScaleSpatialGrid::Query(const FVector& Center, const float Radius, TArray<FHScaleNetGUID>& OutEntities) const
+{
+	const FIntVector MinCell = GetCell(Center - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Center + FVector(Radius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TSet<FHScaleNetGUID>* Bucket = Cells.Find(FIntVector(X, Y, Z));
+				if (!Bucket) continue;
+
+				for (const FHScaleNetGUID& EntityId : *Bucket)
+				{
+					OutEntities.Add(EntityId);
+				}
+			}
+		}
+	}
+}
+
+void FHScaleSpatialGrid::Empty()
+{
+	Cells.Empty();
+	EntityCells.Empty();
+}
+
+FIntVector FHScaleSpatialGrid::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
@@ -5,10 +5,12 @@
 
 #include "quark.h"
 #include "Core/HScaleCommons.h"
+#include "Core/HScaleDevSettings.h"
 #include "Core/HScaleResources.h"
 #include "Engine/ActorChannel.h"
 #include "Events/HScaleEventsDriver.h"
 #include "NetworkLayer/HScaleNetDriver.h"
+#include "NetworkLayer/HScaleNetworkSession.h"
 #include "NetworkLayer/HScalePackageMap.h"
 #include "NetworkLayer/HScaleUpdates.h"
 #include "ReplicationLayer/HScaleRepDriver.h"
@@ -55,37 +57,15 @@ void UHScaleConnection::InitBase(UNetDriver* InDriver, FSocket* InSocket, const
 void UHScaleConnection::Receive()
 {
 	check(IsConnectionActive())
-	session* QuarkSession = GetNetworkSession();
 	const UHScaleNetDriver* NetDriver = Cast<UHScaleNetDriver>(Driver);
 	FHScaleNetworkBibliothec* Bibliothec = NetDriver->GetBibliothec();
-	for (auto Update = QuarkSession->try_receive(); Update;
-	     Update = QuarkSession->try_receive())
-	{
-		if (!Update.has_value()) continue;
-
-		const update_type UpdateType = Update.value().type();
-		if (UpdateType == update_type::player)
-		{
-			const std::optional<remote_player_update> PlayerUpdate = Update.value().player();
-			if (PlayerUpdate.has_value()) { Bibliothec->HandlePlayersNetworkUpdate(PlayerUpdate.value()); }
-		}
-		else if (UpdateType == update_type::object)
-		{
-			const std::optional<remote_object_update> ObjectUpdate = Update.value().object();
-			if (ObjectUpdate.has_value()) { Bibliothec->HandleObjectsNetworkUpdate(ObjectUpdate.value()); }
-		}
-		else if (UpdateType == update_type::event)
-		{
-			const std::optional<remote_event> EventUpdate = Update.value().event();
-			if (EventUpdate.has_value()) { EventsDriver->HandleEvents(EventUpdate.value()); }
-		}
-	}
+	NetworkSession->Receive(*Bibliothec, *EventsDriver);
+	Bibliothec->ResolvePendingClassLoads();
 }
 
 void UHScaleConnection::Send()
 {
 	check(IsConnectionActive())
-	session* QuarkSession = GetNetworkSession();
 	const UHScaleNetDriver* NetDriver = Cast<UHScaleNetDriver>(Driver);
 	FHScaleNetworkBibliothec* Bibliothec = NetDriver->GetBibliothec();
 	TArray<FHScaleLocalUpdate> Updates;
@@ -93,20 +73,10 @@ void UHScaleConnection::Send()
 
 	for (const FHScaleLocalUpdate& Update : Updates)
 	{
-		if (Update.bIsPlayer)
-		{
-			for (const auto& Atb : Update.Attributes)
-			{
-				QuarkSession->send(quark::local_update::player(Atb.AttributeId, Atb.Value), Atb.Qos);
-			}
-		}
-		else
-		{
-			for (const auto& Atb : Update.Attributes)
-			{
-				QuarkSession->send(quark::local_update::object(Update.ObjectId, Atb.AttributeId, Atb.Value), Atb.Qos);
-			}
-		}
+		if (Update.Attributes.IsEmpty()) continue;
+
+		const bool bSuccess = NetworkSession->Send(Update);
+		UE_CLOG(!bSuccess, Log_HyperScaleReplication, Warning, TEXT("Failed to send some attributes of %s %llu"), Update.bIsPlayer ? TEXT("player") : TEXT("object"), Update.ObjectId);
 	}
 }
 
@@ -181,8 +151,19 @@ void UHScaleConnection::PullDataFromMemoryLayer()
 	UHScalePackageMap* PkgMap = Cast<UHScalePackageMap>(PackageMap);
 	check(PkgMap);
 
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation;
+	NetDriver->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Lower value is pulled sooner, an entity left over for N ticks competes as if it was N+1 times closer
+	struct FHScalePullEntry
+	{
+		FHScaleNetGUID EntityId;
+		double Priority;
+	};
+
 	// <<< --- Start of collecting of all actors that needs to be updated in a game simulation
-	TArray<FHScaleNetGUID> FilteredList;
+	TArray<FHScalePullEntry> FilteredList;
 	for (TSet<FHScaleNetGUID>::TConstIterator It = Bibliothec->GetServerDirtyEntitiesIterator(); It; ++It)
 	{
 		const FHScaleNetGUID EntityId = *It;
@@ -203,11 +184,21 @@ void UHScaleConnection::PullDataFromMemoryLayer()
 			continue; // <<< --- Do not include not spawned entities
 		}
 
-		FilteredList.Add(EntityId);
+		double Priority = 0.0; // <<< --- Entities without location are not delayed
+		FVector EntityLocation;
+		if (Entity->GetEntityLocation(EntityLocation))
+		{
+			const double AgeFactor = 1.0 + DeferredPullTicks.FindRef(EntityId);
+			Priority = FVector::DistSquared(ViewLocation, EntityLocation) / FMath::Square(AgeFactor);
+		}
+
+		FilteredList.Add({EntityId, Priority});
 		UE_LOG(Log_HyperScaleMemory, VeryVerbose, TEXT("EntityId %llu is added to filtered list"), EntityId.Get())
 	}
 	// <<< --- End of collecting of all actors that needs to be updated in a game simulation
 
+	FilteredList.Sort([](const FHScalePullEntry& A, const FHScalePullEntry& B) { return A.Priority < B.Priority; });
+
 	/*
 	TArray<FHScaleNetGUID> FilteredListWithOwners;
 	// Go through the filtered list and see if any of the owners are not spawned yet and if so add them to the front of the list 
@@ -244,11 +235,29 @@ void UHScaleConnection::PullDataFromMemoryLayer()
 	}
 	*/
 
+	const double Budget = UHScaleDevSettings::GetPullDataBudgetMs() / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
 	TSet<FHScaleNetGUID> ProcessedList;
+	TMap<FHScaleNetGUID, uint32> LeftoverPullTicks;
 	// Now iterate through filtered list and pull updates from memory layer
 	//for (const FHScaleNetGUID& EntityId : FilteredListWithOwners)
-	for (const FHScaleNetGUID& EntityId : FilteredList)
+	for (int32 Index = 0; Index < FilteredList.Num(); ++Index)
 	{
+		const FHScaleNetGUID EntityId = FilteredList[Index].EntityId;
+
+		// At least one entity is pulled each tick, the rest stays server dirty for next tick
+		if (Index > 0 && Budget > 0.0 && FPlatformTime::Seconds() - StartTime > Budget)
+		{
+			for (; Index < FilteredList.Num(); ++Index)
+			{
+				const FHScaleNetGUID LeftoverId = FilteredList[Index].EntityId;
+				LeftoverPullTicks.Add(LeftoverId, DeferredPullTicks.FindRef(LeftoverId) + 1);
+			}
+			UE_LOG(Log_HyperScaleMemory, Verbose, TEXT("Pull budget exceeded, %d entities left for next tick"), LeftoverPullTicks.Num())
+			break;
+		}
+
 		TSharedPtr<FHScaleNetworkEntity> Entity = Bibliothec->FetchEntity(EntityId);
 		check(Entity);
 
@@ -286,11 +295,11 @@ void UHScaleConnection::PullDataFromMemoryLayer()
 	}
 
 	Bibliothec->ClearServerDirtyEntities(ProcessedList);
+	DeferredPullTicks = MoveTemp(LeftoverPullTicks);
 }
 
 int32 UHScaleConnection::GetFreeChannelIndex(const FName& ChName)
 {
-	int32 ChIndex;
 	int32 FirstChannel = 1;
 
 	const int32 StaticChannelIndex = Driver->ChannelDefinitionMap[ChName].StaticChannelIndex;
@@ -299,26 +308,56 @@ int32 UHScaleConnection::GetFreeChannelIndex(const FName& ChName)
 		FirstChannel = StaticChannelIndex;
 	}
 
-	// Search the channel array for an available location
-	for (ChIndex = FirstChannel; ChIndex < Channels.Num(); ChIndex++)
+	if (ReservedChannelIndices.Num() != Channels.Num())
 	{
-		// const bool bIgnoreReserved = bIgnoreReservedChannels && ReservedChannels.Contains(ChIndex);
-		// const bool bIgnoreRemapped = bAllowExistingChannelIndex && ChannelIndexMap.Contains(ChIndex);
+		RebuildReservedChannelIndices();
+	}
 
-		if (!Channels[ChIndex])
-		{
-			break;
-		}
+	int32 ChIndex = FindAndReserveChannelIndex(FirstChannel);
+	if (ChIndex == INDEX_NONE)
+	{
+		// reclaims indices of entities that never opened their channel
+		RebuildReservedChannelIndices();
+		ChIndex = FindAndReserveChannelIndex(FirstChannel);
 	}
 
-	if (ChIndex == Channels.Num())
+	return ChIndex;
+}
+
+int32 UHScaleConnection::FindAndReserveChannelIndex(const int32 FirstChannel)
+{
+	if (FirstChannel >= ReservedChannelIndices.Num()) { return INDEX_NONE; }
+
+	int32 ChIndex = ReservedChannelIndices.FindAndSetFirstZeroBit(FirstChannel);
+	while (ChIndex != INDEX_NONE && Channels[ChIndex])
 	{
-		ChIndex = INDEX_NONE;
+		// occupied by channel opened outside of allocator, it stays marked until the channel is cleaned up
+		ChIndex = ChIndex + 1 < ReservedChannelIndices.Num() ? ReservedChannelIndices.FindAndSetFirstZeroBit(ChIndex + 1) : INDEX_NONE;
 	}
 
 	return ChIndex;
 }
 
+void UHScaleConnection::RebuildReservedChannelIndices()
+{
+	ReservedChannelIndices.Init(false, Channels.Num());
+	for (int32 ChIndex = 0; ChIndex < Channels.Num(); ++ChIndex)
+	{
+		if (Channels[ChIndex])
+		{
+			ReservedChannelIndices[ChIndex] = true;
+		}
+	}
+}
+
+void UHScaleConnection::ReleaseChannelIndex(const int32 ChIndex)
+{
+	if (ReservedChannelIndices.IsValidIndex(ChIndex))
+	{
+		ReservedChannelIndices[ChIndex] = false;
+	}
+}
+
 void UHScaleConnection::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
@@ -373,14 +412,14 @@ void UHScaleConnection::NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTrave
 void UHScaleConnection::SubscribeRelevancy()
 {
 	// first close players at high frequency
-	NetworkSession->subscribe(
+	NetworkSession->Subscribe(
 		quark::query()
 		.with_radius(HSCALE_SUBSCRIPTION_SHORT_RADIUS)
 		.with_interval(std::chrono::milliseconds(HSCALE_SUBSCRIPTION_SHORT_RADIUS_INTERVAL_MS)),
 		quark::qos::unreliable);
 
 	// then distant players at lower frequency
-	NetworkSession->subscribe(
+	NetworkSession->Subscribe(
 		quark::query()
 		.with_radius(HSCALE_SUBSCRIPTION_LONG_RADIUS)
 		.with_interval(std::chrono::milliseconds(HSCALE_SUBSCRIPTION_LONG_RADIUS_INTERVAL_MS)),
@@ -397,22 +436,14 @@ bool UHScaleConnection::InitHyperScaleConnection()
 	// The URL is stored in master class so we just read data from there
 	check(Driver);
 
-	// Address in format 'address:port'
-	const FString ServerAddressAndPort = FString::Printf(TEXT("%s:%s"), *URL.Host, *FString::FromInt(URL.Port));
-	quark::string ServerAddress = TCHAR_TO_UTF8(*ServerAddressAndPort);
-
-	// Creates a new session with hyperscale server
-	expected<session> NewSession = quark::session::start(ServerAddress); // #todo ... add auth_buffer
-	if (NewSession.has_value())
+	NetworkSession = CreateNetworkSession();
+	if (NetworkSession.IsValid())
 	{
-		NetworkSession = MakeUnique<session>(MoveTemp(*NewSession));
 		EventsDriver = MakeUnique<FHScaleEventsDriver>(this);
 
 		SubscribeRelevancy();
-		NetworkSession->set_tick_interval(std::chrono::milliseconds(HSCALE_DEFAULT_RELIABLE_SEND_TICK_INTERVAL));
 
 		SetConnectionState(USOCK_Open);
-		UE_LOG(Log_HyperScaleGlobals, Log, TEXT("Session successfully created with server %s"), *ServerAddressAndPort);
 
 		UHScaleRepDriver* RepDriver = (UHScaleRepDriver*)Driver->GetReplicationDriver();
 		check(RepDriver);
@@ -430,6 +461,25 @@ bool UHScaleConnection::InitHyperScaleConnection()
 		return true;
 	}
 
+	return false;
+}
+
+TUniquePtr<IHScaleNetworkSession> UHScaleConnection::CreateNetworkSession()
+{
+	// Address in format 'address:port'
+	const FString ServerAddressAndPort = FString::Printf(TEXT("%s:%s"), *URL.Host, *FString::FromInt(URL.Port));
+	quark::string ServerAddress = TCHAR_TO_UTF8(*ServerAddressAndPort);
+
+	// Creates a new session with hyperscale server
+	expected<session> NewSession = quark::session::start(ServerAddress); // #todo ... add auth_buffer
+	if (NewSession.has_value())
+	{
+		NewSession->set_tick_interval(std::chrono::milliseconds(HSCALE_DEFAULT_RELIABLE_SEND_TICK_INTERVAL));
+		UE_LOG(Log_HyperScaleGlobals, Log, TEXT("Session successfully created with server %s"), *ServerAddressAndPort);
+
+		return MakeUnique<FHScaleQuarkSession>(MoveTemp(*NewSession));
+	}
+
 #if !UE_BUILD_SHIPPING
 
 	UE_LOG(Log_HyperScaleGlobals, Error, TEXT("Session could not be started with server %s. Failed with error: %hs"),
@@ -437,24 +487,13 @@ bool UHScaleConnection::InitHyperScaleConnection()
 
 #endif
 
-	return false;
+	return nullptr;
 }
 
 quark_session_id_t UHScaleConnection::GetNetworkSessionId() const
 {
-	quark_session_id_t Result = 0;
-
-	const quark::session* Session = GetNetworkSession();
-	if (Session)
-	{
-		expected<quark_session_id_t> SessionId = Session->id();
-		if (SessionId.has_value())
-		{
-			Result = SessionId.value<quark_session_id_t>();
-		}
-	}
-
-	return Result;
+	const IHScaleNetworkSession* Session = GetNetworkSession();
+	return Session ? Session->GetId() : 0;
 }
 
 bool UHScaleConnection::IsConnectionFullyEstablished() const
@@ -464,18 +503,13 @@ bool UHScaleConnection::IsConnectionFullyEstablished() const
 
 quark_session_id_t UHScaleConnection::GetSessionId() const
 {
-	const session* Session = GetNetworkSession();
+	const IHScaleNetworkSession* Session = GetNetworkSession();
 	if (Session == nullptr)
 	{
 		return 0;
 	}
 
-	const expected<quark_session_id_t> AssignedId = Session->id();
-	if (!AssignedId.has_value())
-	{
-		return 0;
-	}
-	return *AssignedId;
+	return Session->GetId();
 }
 
 FHScaleNetGUID UHScaleConnection::GetSessionNetGUID() const
@@ -529,8 +563,6 @@ uint64 UHScaleConnection::GetNewHScaleObjectId(UObject* Object)
 {
 	if (!IsConnectionActive()) { return 0; }
 
-	session* Session = GetNetworkSession();
-
 	uint64 ObjectId;
 	TGUID_Cache& RelevantCache = (Object && Object->IsFullNameStableForNetworking()) ? FreeGlobalObjectIDCache : FreePlayerObjectIDCache;
 	if (!RelevantCache.Dequeue(ObjectId))
@@ -3,15 +3,18 @@
 
 #include "NetworkLayer/HScaleNetDriver.h"
 
+#include "BookKeeper/HSClassTranslator.h"
 #include "NetworkLayer/HScaleConnection.h"
 #include "Core/HScaleResources.h"
 #include "Engine/NetworkObjectList.h"
 #include "Engine/ActorChannel.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/DataChannel.h"
+#include "Net/RepLayout.h"
 #include "Net/Core/Trace/NetTrace.h"
 #include "ReplicationLayer/HScaleActorChannel.h"
 #include "ReplicationLayer/HScaleRepDriver.h"
+#include "Utils/HScaleStatics.h"
 
 DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush"), STAT_NetTickFlush, STATGROUP_Game);
 
@@ -53,6 +56,9 @@ bool UHScaleNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, co
 		const uint32 SessionId = Connection->GetSessionId();
 		Bibliothec->CreateLocalPlayerEntity(SessionId);
 
+		// Start loading known entity classes before the first server updates need them
+		FHSClassTranslator::GetInstance().WarmUpClassCache();
+
 		// ReplicationLayer = NewObject<UHScaleReplicationLayer>(this);
 		// ReplicationLayer->Initialize(this);
 	}
@@ -522,17 +528,32 @@ bool UHScaleNetDriver::IsNetworkSessionActive() const
 	return IsValid(Connection) && Connection->IsConnectionActive();
 }
 
-UHScaleConnection* UHScaleNetDriver::GetHyperScaleConnection() const
+void UHScaleNetDriver::AddClientConnection(UNetConnection* NewConnection)
+{
+	Super::AddClientConnection(NewConnection);
+
+	if (UHScaleConnection* CastedConnection = Cast<UHScaleConnection>(NewConnection); CastedConnection && !HyperScaleConnection.IsValid())
+	{
+		HyperScaleConnection = CastedConnection;
+	}
+}
+
+void UHScaleNetDriver::RemoveClientConnection(UNetConnection* ClientConnectionToRemove)
 {
+	Super::RemoveClientConnection(ClientConnectionToRemove);
+
+	if (ClientConnectionToRemove != HyperScaleConnection.Get()) return;
+
+	// fallback to next hyperscale connection in the list, if there is any
+	HyperScaleConnection.Reset();
 	for (UNetConnection* Connection : ClientConnections)
 	{
 		if (UHScaleConnection* CastedConnection = Cast<UHScaleConnection>(Connection))
 		{
-			return CastedConnection;
+			HyperScaleConnection = CastedConnection;
+			break;
 		}
 	}
-
-	return nullptr;
 }
 
 void UHScaleNetDriver::GetPlayerViewPoint(FVector& Location, FRotator& Rotation) const
@@ -566,6 +587,67 @@ TSharedPtr<FRepLayout> UHScaleNetDriver::GetObjectClassRepLayout_Copy(UClass* Cl
 	return *RepLayoutPtr;
 }
 
+int32 UHScaleNetDriver::GetOwnerCmdIndex(UClass* InClass, const FRepLayout& RepLayout)
+{
+	if (const int32* CachedIndex = OwnerCmdIndexMap.Find(InClass))
+	{
+		return *CachedIndex;
+	}
+
+	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, &RepLayout, Cmds);
+	const TArray<FRepParentCmd>& ParentCmds = HSCALE_GET_PRIVATE(FRepLayout, &RepLayout, Parents);
+
+	int32 OwnerCmdIndex = INDEX_NONE;
+	for (int32 CmdIndex = 0; CmdIndex < Cmds.Num(); ++CmdIndex)
+	{
+		const FRepLayoutCmd& RepCmd = Cmds[CmdIndex];
+		if (RepCmd.Type == ERepLayoutCmdType::Return || !RepCmd.Property) continue;
+
+		// only the top level property is the actor owner, not members of structs named the same
+		const bool bIsChildProperty = ParentCmds[RepCmd.ParentIndex].Property != RepCmd.Property;
+		if (!bIsChildProperty && FHScaleStatics::IsObjectDataRepCmd(RepCmd) && RepCmd.Property->GetFName() == TEXT("Owner"))
+		{
+			OwnerCmdIndex = CmdIndex;
+			break;
+		}
+	}
+
+	OwnerCmdIndexMap.Add(InClass, OwnerCmdIndex);
+	return OwnerCmdIndex;
+}
+
+const TArray<uint16>& UHScaleNetDriver::GetHandleToCmdIndexTable(UClass* InClass, const FRepLayout& RepLayout)
+{
+	if (const TUniquePtr<TArray<uint16>>* CachedTable = HandleToCmdIndexMap.Find(InClass))
+	{
+		return **CachedTable;
+	}
+
+	const TArray<FRepLayoutCmd>& Cmds = HSCALE_GET_PRIVATE(FRepLayout, &RepLayout, Cmds);
+
+	TArray<uint16>& Table = *HandleToCmdIndexMap.Add(InClass, MakeUnique<TArray<uint16>>());
+	for (int32 CmdIndex = 0; CmdIndex < Cmds.Num(); ++CmdIndex)
+	{
+		const FRepLayoutCmd& RepCmd = Cmds[CmdIndex];
+		if (RepCmd.Type == ERepLayoutCmdType::Return) continue;
+
+		const uint16 Handle = RepCmd.RelativeHandle;
+		while (Table.Num() <= Handle)
+		{
+			Table.Add(UINT16_MAX);
+		}
+		Table[Handle] = CmdIndex;
+
+		// cmds of array elements have handles relative to the element, they are resolved by array owner
+		if (RepCmd.Type == ERepLayoutCmdType::DynamicArray)
+		{
+			CmdIndex = RepCmd.EndCmd - 1;
+		}
+	}
+
+	return Table;
+}
+
 void UHScaleNetDriver::ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject)
 {
 	if (Actor->IsActorBeingDestroyed())
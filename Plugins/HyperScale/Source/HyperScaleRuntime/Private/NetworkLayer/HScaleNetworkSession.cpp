@@ -0,0 +1,83 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+
+#include "NetworkLayer/HScaleNetworkSession.h"
+
+#include "Events/HScaleEventsDriver.h"
+#include "MemoryLayer/HScaleNetworkBibliothec.h"
+#include "NetworkLayer/HScaleUpdates.h"
+
+using namespace quark;
+
+bool FHScaleQuarkSession::Send(const FHScaleLocalUpdate& Update)
+{
+	bool bSuccess = true;
+	for (const FHScaleAttributesUpdate& Atb : Update.Attributes)
+	{
+		const local_update LocalUpdate = Update.bIsPlayer ? local_update::player(Atb.AttributeId, Atb.Value) : local_update::object(Update.ObjectId, Atb.AttributeId, Atb.Value);
+		bSuccess &= !Session.send(LocalUpdate, Atb.Qos).error().is_error();
+	}
+	return bSuccess;
+}
+
+bool FHScaleQuarkSession::SendEvent(const quark_event_class_t EventClass, const recipient& Recipient, const uint8* Data, const size_t Size, const qos Qos)
+{
+	const local_event Event(EventClass, Recipient, Data, Size);
+	const error ResultError = Session.send(local_update::event(Event), Qos).error();
+	if (ResultError.is_error())
+	{
+		UE_LOG(Log_HyperScaleEvents, Error, TEXT("Quark event send error: %hs"), ResultError.message());
+		return false;
+	}
+	return true;
+}
+
+bool FHScaleQuarkSession::Subscribe(const query& Query, const qos Qos)
+{
+	return Session.subscribe(Query, Qos).has_value();
+}
+
+void FHScaleQuarkSession::Receive(FHScaleNetworkBibliothec& Bibliothec, FHScaleEventsDriver& EventsDriver)
+{
+	for (auto Update = Session.try_receive(); Update;
+	     Update = Session.try_receive())
+	{
+		if (!Update.has_value()) continue;
+
+		const update_type UpdateType = Update.value().type();
+		if (UpdateType == update_type::player)
+		{
+			const std::optional<remote_player_update> PlayerUpdate = Update.value().player();
+			if (PlayerUpdate.has_value())
+			{
+				Bibliothec.HandlePlayersNetworkUpdate(PlayerUpdate->player_id(), PlayerUpdate->attribute_id(), PlayerUpdate->value(), PlayerUpdate->timestamp());
+			}
+		}
+		else if (UpdateType == update_type::object)
+		{
+			const std::optional<remote_object_update> ObjectUpdate = Update.value().object();
+			if (ObjectUpdate.has_value())
+			{
+				Bibliothec.HandleObjectsNetworkUpdate(ObjectUpdate->object_id(), ObjectUpdate->attribute_id(), ObjectUpdate->value(), ObjectUpdate->timestamp());
+			}
+		}
+		else if (UpdateType == update_type::event)
+		{
+			const std::optional<remote_event> EventUpdate = Update.value().event();
+			if (EventUpdate.has_value())
+			{
+				FHScaleRemoteEvent Event;
+				Event.EventClass = EventUpdate->event_class();
+				Event.Data = EventUpdate->data();
+				Event.Size = EventUpdate->size();
+				Event.bFromPlayer = EventUpdate->sender().is_player();
+				EventsDriver.HandleEvents(Event);
+			}
+		}
+	}
+}
+
+quark_session_id_t FHScaleQuarkSession::GetId() const
+{
+	return Session.id();
+}
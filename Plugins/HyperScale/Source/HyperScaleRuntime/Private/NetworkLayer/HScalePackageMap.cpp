@@ -1046,6 +1046,38 @@ void UHScalePackageMap::CleanUpObjectGuid(const FNetworkGUID NetGUID)
 	}
 
 	ObjectGuidMapToNetGuid.Remove(NetGUID);
+
+	FHScaleObjectPathKey PathKey;
+	if (ObjectPathCacheKeys.RemoveAndCopyValue(NetGUID, PathKey))
+	{
+		ObjectPathCache.Remove(PathKey);
+	}
+}
+
+UObject* UHScalePackageMap::FindObjectByPath_HS(UObject* Outer, const FString& ObjectName, FNetworkGUID& OutNetGUID)
+{
+	const FHScaleObjectPathKey PathKey{FObjectKey(Outer), ObjectName};
+	if (const FHScaleCachedObjectPath* CachedPath = ObjectPathCache.Find(PathKey))
+	{
+		if (UObject* Object = CachedPath->Object.Get())
+		{
+			OutNetGUID = CachedPath->NetGUID;
+			return Object;
+		}
+
+		// object was destroyed, path can be resolved to new instance
+		ObjectPathCacheKeys.Remove(CachedPath->NetGUID);
+		ObjectPathCache.Remove(PathKey);
+	}
+
+	UObject* Object = StaticFindObject(UObject::StaticClass(), Outer, *ObjectName, false);
+	AssignNetGUID(OutNetGUID, Object);
+	if (Object && OutNetGUID.IsValid())
+	{
+		ObjectPathCache.Add(PathKey, {Object, OutNetGUID});
+		ObjectPathCacheKeys.Add(OutNetGUID, PathKey);
+	}
+	return Object;
 }
 
 
@@ -33,6 +33,15 @@ void UHScaleRelevancyManager::Initialize(UHScaleConnection* NetConnection)
 
 	CachedPackageMap = Cast<UHScalePackageMap>(CachedNetConnection->PackageMap);
 	check(IsValid(CachedPackageMap));
+
+	// Actor entities received before the manager existed, later ones are tracked by bibliothec
+	if (const FHScaleNetworkBibliothec* Bibliothec = CachedNetDriver->GetBibliothec())
+	{
+		for (TSet<FHScaleNetGUID>::TConstIterator It = Bibliothec->FetchIteratorPerFlag(EHScaleEntityFlags::IsActor); It; ++It)
+		{
+			TrackEntityDormancy(*It);
+		}
+	}
 }
 
 void UHScaleRelevancyManager::Tick(float DeltaTime)
@@ -43,7 +52,7 @@ void UHScaleRelevancyManager::Tick(float DeltaTime)
 	if (!IsValid(CachedNetConnection) || !CachedNetConnection->IsConnectionActive()) return;
 
 	CurrentRelevancyDeltaTime += DeltaTime;
-	CurrentDormancyDeltaTime += DeltaTime;
+	CurrentDormancyTime += DeltaTime;
 
 	// Cache view target location
 	bool bLocationIsChanged = false;
@@ -74,11 +83,7 @@ void UHScaleRelevancyManager::Tick(float DeltaTime)
 		CheckRelevancy(bLocationIsChanged);
 	}
 
-	if (CurrentDormancyDeltaTime >= DormancyCheckPeriod)
-	{
-		CurrentDormancyDeltaTime = 0;
-		CheckDormancy();
-	}
+	CheckDormancy();
 }
 
 void UHScaleRelevancyManager::CheckRelevancy(const bool bLocationIsChanged)
@@ -121,16 +126,30 @@ void UHScaleRelevancyManager::CheckRelevancy(const bool bLocationIsChanged)
 
 	if (bLocationIsChanged)
 	{
-		// Iterate over all network actor entities, because if the owning view target was changed
-		// it can affect any entity around a player
+		// If the owning view target was changed it can affect any entity around a player,
+		// so check all actor entities in the grid cells around the view location
 
 		// --- GATHER NEW RELEVANT NETGUIDS IN SEPARATE SET ---
 
-		TSet<FHScaleNetGUID>::TConstIterator ActorEntitiesIt = Bibliothec->FetchIteratorPerFlag(EHScaleEntityFlags::IsActor);
-		for (; ActorEntitiesIt; ++ActorEntitiesIt)
+		RelevancyCandidates.Reset();
+		Bibliothec->QueryActorEntitiesInRadius(LastViewTargetLocation.GetValue(), MAX_SERVER_RELEVANCY_DISTANCE, RelevancyCandidates);
+
+		// Owners are relevant through their children, even if they are outside of the queried cells
+		constexpr int32 MaxOwnerDepth = 8; // guards against ownership cycles
+		const int32 NumInRange = RelevancyCandidates.Num();
+		for (int32 Index = 0; Index < NumInRange; ++Index)
+		{
+			const TSharedPtr<FHScaleNetworkEntity> Entity = Bibliothec->FindExistingEntity(RelevancyCandidates[Index]);
+			FHScaleNetworkEntity* OwnerEntity = Entity.IsValid() ? Entity->GetOwner() : nullptr;
+			for (int32 Depth = 0; Depth < MaxOwnerDepth && OwnerEntity && OwnerEntity->IsActor() && !RelevantEntities.Contains(OwnerEntity->EntityId); ++Depth)
+			{
+				RelevancyCandidates.Add(OwnerEntity->EntityId);
+				OwnerEntity = OwnerEntity->GetOwner();
+			}
+		}
+
+		for (const FHScaleNetGUID& NetGUID : RelevancyCandidates)
 		{
-			const FHScaleNetGUID NetGUID = *ActorEntitiesIt;
-			// UE_LOG(Log_HyperScaleReplication, Log, TEXT("Checking entity with id: %s"), *NetGUID.ToString());
 			CheckRelevancy_Internal(NetGUID, *RepDriver, *Bibliothec);
 		}
 	}
@@ -157,6 +176,9 @@ void UHScaleRelevancyManager::CheckDormancy()
 	check(CachedPackageMap);
 	check(CachedNetConnection);
 
+	if (DormancyQueue.IsEmpty() || DormancyQueue.HeapTop().CheckTime > CurrentDormancyTime) return;
+	if (!LastViewTargetLocation.IsSet()) return;
+
 	FHScaleNetworkBibliothec* Bibliothec = CachedNetDriver->GetBibliothec();
 	if (!Bibliothec)
 	{
@@ -171,48 +193,61 @@ void UHScaleRelevancyManager::CheckDormancy()
 		return;
 	}
 
-	TSet<FHScaleNetGUID>::TConstIterator ActorEntitiesIt = Bibliothec->FetchIteratorPerFlag(EHScaleEntityFlags::IsActor);
-
-	// --- GATHER NEW RELEVANT NETGUIDS IN SEPARATE SET ---
-	for (; ActorEntitiesIt; ++ActorEntitiesIt)
+	// Only expired entries are processed, and only until the budget for this tick is spent
+	const double StartTime = FPlatformTime::Seconds();
+	while (!DormancyQueue.IsEmpty() && DormancyQueue.HeapTop().CheckTime <= CurrentDormancyTime)
 	{
-		const FHScaleNetGUID& NetGUID = *ActorEntitiesIt;
+		if (FPlatformTime::Seconds() - StartTime > DormancyCheckBudget) break;
+
+		FHScaleDormancyEntry Entry;
+		DormancyQueue.HeapPop(Entry, false);
 
-		// Add newly relevant entities
-		if (RelevantEntities.Contains(NetGUID))
+		FHScaleDormancyState* State = DormancyStates.Find(Entry.NetGUID);
+		if (!State || State->ScheduledCheckTime != Entry.CheckTime) continue; // <<< --- Entity was cleared or rescheduled meanwhile
+
+		if (!Bibliothec->IsEntityExists(Entry.NetGUID))
 		{
-			EntitiesInDormantState.Remove(NetGUID);
+			DormancyStates.Remove(Entry.NetGUID);
+			continue;
 		}
-		else
+
+		// Entity was relevant after the entry was scheduled, so check it again later
+		const double ExpireTime = State->LastRelevantTime + DormancyCheckPeriod;
+		if (ExpireTime > CurrentDormancyTime)
+		{
+			ScheduleDormancyCheck(Entry.NetGUID, *State, ExpireTime);
+			continue;
+		}
+
+		bool bIsOutOfServerRelevancy = false;
+		if (!RelevantEntities.Contains(Entry.NetGUID))
 		{
-			const TSharedPtr<FHScaleNetworkEntity> Entity = Bibliothec->FetchEntity(NetGUID);
+			const TSharedPtr<FHScaleNetworkEntity> Entity = Bibliothec->FetchEntity(Entry.NetGUID);
 
 			FVector RelevantEntityPos;
 			if (Entity->GetEntityLocation(RelevantEntityPos))
 			{
-				const float Distance = FVector::Dist(LastViewTargetLocation.GetValue(), RelevantEntityPos);
-				if (Distance > MAX_SERVER_RELEVANCY_DISTANCE)
-				{
-					if (EntitiesInDormantState.Contains(NetGUID))
-					{
-						const bool bFlushResult = RepDriver->FlushEntity(NetGUID);
-						if (bFlushResult)
-						{
-							EntitiesInDormantState.Remove(NetGUID);
-						}
-					}
-					else
-					{
-						// Save the entity as a dormant and in the next dormant check we will remove it
-						EntitiesInDormantState.Add(NetGUID);
-					}
-				}
-				else
-				{
-					EntitiesInDormantState.Remove(NetGUID);
-				}
+				bIsOutOfServerRelevancy = FVector::DistSquared(LastViewTargetLocation.GetValue(), RelevantEntityPos) > FMath::Square(MAX_SERVER_RELEVANCY_DISTANCE);
 			}
 		}
+
+		if (!bIsOutOfServerRelevancy)
+		{
+			State->LastRelevantTime = CurrentDormancyTime;
+			ScheduleDormancyCheck(Entry.NetGUID, *State, CurrentDormancyTime + DormancyCheckPeriod);
+			continue;
+		}
+
+		// Flushing also clears the entity from this manager through ClearEntity()
+		const bool bFlushResult = RepDriver->FlushEntity(Entry.NetGUID);
+		if (bFlushResult)
+		{
+			DormancyStates.Remove(Entry.NetGUID);
+		}
+		else
+		{
+			ScheduleDormancyCheck(Entry.NetGUID, *State, CurrentDormancyTime + DormancyCheckPeriod);
+		}
 	}
 }
 
@@ -221,10 +256,33 @@ void UHScaleRelevancyManager::ClearEntity(const FHScaleNetGUID NetGUID)
 	if (NetGUID.IsValid())
 	{
 		RelevantEntities.Remove(NetGUID);
-		EntitiesInDormantState.Remove(NetGUID);
+		DormancyStates.Remove(NetGUID); // <<< --- Queued entry is skipped once it expires
+	}
+}
+
+void UHScaleRelevancyManager::TrackEntityDormancy(const FHScaleNetGUID NetGUID)
+{
+	if (!NetGUID.IsValid() || DormancyStates.Contains(NetGUID)) return;
+
+	FHScaleDormancyState& State = DormancyStates.Add(NetGUID);
+	State.LastRelevantTime = CurrentDormancyTime;
+	ScheduleDormancyCheck(NetGUID, State, CurrentDormancyTime + DormancyCheckPeriod);
+}
+
+void UHScaleRelevancyManager::MarkEntityRelevantForDormancy(const FHScaleNetGUID NetGUID)
+{
+	if (FHScaleDormancyState* State = DormancyStates.Find(NetGUID))
+	{
+		State->LastRelevantTime = CurrentDormancyTime;
 	}
 }
 
+void UHScaleRelevancyManager::ScheduleDormancyCheck(const FHScaleNetGUID NetGUID, FHScaleDormancyState& State, const double CheckTime)
+{
+	State.ScheduledCheckTime = CheckTime;
+	DormancyQueue.HeapPush({NetGUID, CheckTime});
+}
+
 void UHScaleRelevancyManager::CheckRelevancy_Internal(const FHScaleNetGUID& NetGUID, UHScaleRepDriver& RepDriver, FHScaleNetworkBibliothec& Bibliothec)
 {
 	// Add newly relevant entities
@@ -244,7 +302,7 @@ void UHScaleRelevancyManager::CheckRelevancy_Internal(const FHScaleNetGUID& NetG
 	if (RelevantEntities.Contains(NetGUID) || IsEntityServerRelevantToPlayer(Bibliothec.FetchEntity(NetGUID)))
 	{
 		// If the entity is relevant or in server relevant distance, then cannot be in dormant state
-		EntitiesInDormantState.Remove(NetGUID);
+		MarkEntityRelevantForDormancy(NetGUID);
 	}
 }
 
@@ -303,10 +361,9 @@ bool UHScaleRelevancyManager::IsActorNetRelevantToPlayer(const FHScaleNetGUID Ne
 	}
 
 	const float DistanceSquared = FVector::DistSquared(LastViewTargetLocation.GetValue(), RelevantEntityPos);
-	const float Distance = FMath::Sqrt(DistanceSquared);
 
 	// Relevant only in the case if the distance doest exceed max server distance value
-	if (Distance > MAX_SERVER_RELEVANCY_DISTANCE)
+	if (DistanceSquared > FMath::Square(MAX_SERVER_RELEVANCY_DISTANCE))
 	{
 		return false;
 	}
@@ -335,10 +392,10 @@ bool UHScaleRelevancyManager::IsEntityServerRelevantToPlayer(const TSharedPtr<FH
 	FVector RelevantEntityPos;
 	if (EntityToCheck->GetEntityLocation(RelevantEntityPos))
 	{
-		const float Distance = FVector::Dist(LastViewTargetLocation.GetValue(), RelevantEntityPos);
+		const float DistanceSquared = FVector::DistSquared(LastViewTargetLocation.GetValue(), RelevantEntityPos);
 
 		// Relevant only in the case if the distance doest exceed max server distance value
-		bResult = Distance <= MAX_SERVER_RELEVANCY_DISTANCE;
+		bResult = DistanceSquared <= FMath::Square(MAX_SERVER_RELEVANCY_DISTANCE);
 	}
 
 	return bResult;
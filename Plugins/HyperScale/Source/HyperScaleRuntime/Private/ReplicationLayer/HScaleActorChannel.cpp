@@ -767,10 +767,19 @@ bool UHScaleActorChannel::CleanUp(const bool bForDestroy, EChannelCloseReason Cl
 
 	// <<< ---- Now we have cached all NetGUIDs that can be removed after successful clean up
 
+	// Super clears connection, so the index is released through cached one
+	UHScaleConnection* HScaleConnection = Cast<UHScaleConnection>(Connection);
+	const int32 ClosedChIndex = ChIndex;
+
 	// Some of super functionality is focused for client behavior
 	// so before calling this, we're acting as a client and then reverting the state back
 	const bool bResult = Super::CleanUp(bForDestroy, CloseReason);
 
+	if (HScaleConnection)
+	{
+		HScaleConnection->ReleaseChannelIndex(ClosedChIndex);
+	}
+
 	// Remove all network GUIDs from cache, because from this point are deprecated
 	for (const FNetworkGUID Guid : GuidsToRemoveFromMap)
 	{
@@ -165,12 +165,19 @@ int32 UHScaleRepDriver::ServerReplicateActors(float DeltaSeconds)
 	FNetworkObjectList& RepObjectList = CachedNetDriver->GetNetworkObjectList();
 	const TSet<TSharedPtr<FNetworkObjectInfo>, FNetworkObjectKeyFuncs>& ActiveRepObjects = RepObjectList.GetActiveObjects();
 
-	// #todo ... iterate only group actors
+	const double WorldTime = CachedNetDriver->GetWorld()->GetTimeSeconds();
+
+	// Dormant actors are moved out of the active list once they are in memory layer,
+	// so only awake actors are iterated here and the cheap time check goes first
+	TArray<AActor*> ActorsToDormant;
 	for (const TSharedPtr<FNetworkObjectInfo> NetworkObject : ActiveRepObjects)
 	{
 		// Skip not valid actors or actors with paused replication
 		if (!IsValid(NetworkObject->Actor) || !NetworkObject->Actor->GetIsReplicated()) continue;
 
+		// Honour NetUpdateFrequency, ForceNetUpdate() resets the time to replicate the actor in this tick
+		if (!NetworkObject->bPendingNetUpdate && NetworkObject->NextUpdateTime > WorldTime) continue;
+
 		AActor* ActorToCheck = NetworkObject->Actor;
 		const ENetRole ActorRole = ActorToCheck->GetLocalRole();
 
@@ -216,11 +223,62 @@ int32 UHScaleRepDriver::ServerReplicateActors(float DeltaSeconds)
 		check(ActorChannel);
 
 		ActorChannel->ReplicateActorToMemoryLayer();
+		++Result;
+
+		NetworkObject->bPendingNetUpdate = false;
+		NetworkObject->LastNetReplicateTime = WorldTime;
+		NetworkObject->NextUpdateTime = WorldTime + FMath::SRand() * DeltaSeconds + 1.0 / FMath::Max(ActorToCheck->NetUpdateFrequency, UE_KINDA_SMALL_NUMBER);
+
+		// Once the actor exists in network it can sleep until its dormancy is flushed
+		if (ActorToCheck->NetDormancy > DORM_Awake && PackageMap->DoesNetEntityExist(ActorToCheck))
+		{
+			ActorsToDormant.Add(ActorToCheck);
+		}
+	}
+
+	for (AActor* Actor : ActorsToDormant)
+	{
+		RepObjectList.MarkDormant(Actor, Connection, 1, CachedNetDriver);
 	}
 
 	return Result;
 }
 
+void UHScaleRepDriver::ForceNetUpdate(AActor* Actor)
+{
+	if (!IsValid(CachedNetDriver)) return;
+
+	if (FNetworkObjectInfo* NetworkObject = CachedNetDriver->FindNetworkObjectInfo(Actor))
+	{
+		NetworkObject->bPendingNetUpdate = true;
+	}
+}
+
+void UHScaleRepDriver::FlushNetDormancy(AActor* Actor, bool WasDormInitial)
+{
+	WakeUpActor(Actor);
+}
+
+void UHScaleRepDriver::NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState)
+{
+	if (!IsValid(Actor)) return;
+
+	// Going to sleep is handled after the next replication of the actor
+	if (Actor->NetDormancy <= DORM_Awake)
+	{
+		WakeUpActor(Actor);
+	}
+}
+
+void UHScaleRepDriver::WakeUpActor(AActor* Actor)
+{
+	if (!IsValid(CachedNetDriver)) return;
+	if (!IsValid(CachedConnection)) return;
+
+	CachedNetDriver->GetNetworkObjectList().MarkActive(Actor, CachedConnection, CachedNetDriver);
+	ForceNetUpdate(Actor);
+}
+
 bool UHScaleRepDriver::SetEntityInStagingMode(const FHScaleNetGUID EntityGUID)
 {
 	if (!IsValid(CachedNetDriver)) return false;
@@ -376,7 +434,7 @@ bool UHScaleRepDriver::FlushEntity(const FHScaleNetGUID EntityGUID, const bool b
 
 	if(bSendForgetEvent)
 	{
-		CachedConnection->GetEventsDriver()->SendForgetObjectsEvent(EntityGUID);
+		CachedConnection->GetEventsDriver()->MarkEntityForForget(EntityGUID);
 	}
 	
 	Bibliothec->DestroyEntity(EntityGUID);
@@ -385,6 +443,9 @@ bool UHScaleRepDriver::FlushEntity(const FHScaleNetGUID EntityGUID, const bool b
 
 void UHScaleRepDriver::OnConnectionEstablished(const FURL& URL)
 {
+	// level roles are read from url of the new connection
+	InvalidateReplicationRulesCache();
+
 	FString HyperscaleAddressAndPort = URL.GetOption(HYPERSCALE_LEVEL_OPTION, TEXT(""));
 	HyperscaleAddressAndPort.ReplaceInline(TEXT("="), TEXT(""));
 	HyperscaleAddressAndPort = HyperscaleAddressAndPort.TrimStart().TrimEnd(); // Remove white spaces
@@ -429,29 +490,46 @@ bool UHScaleRepDriver::IsAllowedToReplicate(const AActor* Actor) const
 	if (!IsValid(CachedNetDriver)) return false;
 	if (!IsValid(Actor)) return false;
 
+	UClass* ActorClass = Actor->GetClass();
+	const FHScaleClassReplicationInfo& ClassInfo = GetClassReplicationInfo(ActorClass);
+	if (!ClassInfo.bAllowedByRule || !ClassInfo.bClassSupported) return false;
+
+	// most of actors are spawned from class default object, others has to be checked one by one
+	const UObject* Archetype = Actor->IsNetStartupActor() ? Actor : Actor->GetArchetype();
+	if (Archetype == ActorClass->GetDefaultObject(false))
+	{
+		return ClassInfo.bDefaultObjectSupported;
+	}
+
+	// Actor is not supported by default from engine
+	return CachedNetDriver->GuidCache->SupportsObject(Archetype);
+}
+
+const FHScaleClassReplicationInfo& UHScaleRepDriver::GetClassReplicationInfo(UClass* Class) const
+{
+	if (const FHScaleClassReplicationInfo* CachedInfo = ClassReplicationInfoCache.Find(Class))
+	{
+		return *CachedInfo;
+	}
+
 	const TArray<FHScale_ReplicationClassOptions>& RepOptions = UHScaleDevSettings::GetClassesReplicationOptions();
 
-	const TSubclassOf<AActor> ActorClass = Actor->GetClass();
-	const FHScale_ReplicationClassOptions* ClassOptions = RepOptions.FindByPredicate([ActorClass](const FHScale_ReplicationClassOptions& Other)
+	const FHScale_ReplicationClassOptions* ClassOptions = RepOptions.FindByPredicate([Class](const FHScale_ReplicationClassOptions& Other)
 	{
-		return Other.ActorClass.IsValid() && (ActorClass.Get() == Other.ActorClass.Get() || ActorClass->IsChildOf(Other.ActorClass.Get()));
+		return Other.ActorClass.IsValid() && (Class == Other.ActorClass.Get() || Class->IsChildOf(Other.ActorClass.Get()));
 	});
 
-	bool bResult = true;
+	FHScaleClassReplicationInfo& Info = ClassReplicationInfoCache.Add(Class);
+	Info.bAllowedByRule = true;
 	if (ClassOptions && ClassOptions->ReplicationCondition.IsValid())
 	{
 		const FHyperScale_ReplicationRule& RepCondition = ClassOptions->ReplicationCondition.Get<FHyperScale_ReplicationRule>();
-		bResult = RepCondition.IsReplicated(CachedNetDriver->GetHyperScaleConnection());
-
-		// #todo ... maybe we could cache the result into RepDriver and not to compute it all the time when requesting this function for result
+		Info.bAllowedByRule = RepCondition.IsReplicated(CachedNetDriver->GetHyperScaleConnection());
 	}
 
 	const FNetGUIDCache* GuidCache = CachedNetDriver->GuidCache.Get();
-	if (!GuidCache->SupportsObject(Actor->GetClass()) || !GuidCache->SupportsObject(Actor->IsNetStartupActor() ? Actor : Actor->GetArchetype()))
-	{
-		// Actor is not supported by default from engine
-		bResult = false;
-	}
+	Info.bClassSupported = GuidCache->SupportsObject(Class);
+	Info.bDefaultObjectSupported = GuidCache->SupportsObject(Class->GetDefaultObject(false));
 
-	return bResult;
+	return Info;
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "Utils/HScaleBitWriterPool.h"
+
+FHScaleBitWriterPool& FHScaleBitWriterPool::Get()
+{
+	static thread_local FHScaleBitWriterPool Pool;
+	return Pool;
+}
+
+TUniquePtr<FBitWriter> FHScaleBitWriterPool::Acquire(const int64 MaxBits)
+{
+	TArray<TUniquePtr<FBitWriter>>* Writers = FreeWriters.Find(MaxBits);
+	if (Writers && !Writers->IsEmpty())
+	{
+		return Writers->Pop(false);
+	}
+	return MakeUnique<FBitWriter>(MaxBits);
+}
+
+void FHScaleBitWriterPool::Release(TUniquePtr<FBitWriter>&& Writer)
+{
+	if (!Writer.IsValid()) return;
+
+	TArray<TUniquePtr<FBitWriter>>& Writers = FreeWriters.FindOrAdd(Writer->GetMaxBits());
+	if (Writers.Num() >= MaxPooledWritersPerSize) return;
+
+	// Reset keeps the buffer allocation, only clears the written bits and the archive state
+	Writer->Reset();
+	Writers.Add(MoveTemp(Writer));
+}
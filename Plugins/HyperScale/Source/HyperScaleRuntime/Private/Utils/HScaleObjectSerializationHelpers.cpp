@@ -3,7 +3,7 @@
 #include "MemoryLayer/HScaleNetworkBibliothec.h"
 #include "NetworkLayer/HScalePackageMap.h"
 
-void FHScaleObjectSerializationHelper::LoadObject(UObject*& Object, TArray<FHScaleOuterChunk>& Chunks, FNetworkGUID& NetGUID, UHScalePackageMap* PkgMap)
+void FHScaleObjectSerializationHelper::LoadObject(UObject*& Object, TArray<FHScaleOuterChunk>& Chunks, FNetworkGUID& NetGUID, UHScalePackageMap* PkgMap, FString* OutMissingPackage)
 {
 	check(PkgMap)
 
@@ -18,9 +18,13 @@ void FHScaleObjectSerializationHelper::LoadObject(UObject*& Object, TArray<FHSca
 			UE_LOG(Log_HyperScaleMemory, VeryVerbose, TEXT("Chunk After load is flags: %d HS_NETGUID: %llu AttrId: %d Name: %s  ObjVa: %s	NetGUID:%s"), Ele.ExportFlags, Ele.HS_NetGUID.Get(), Ele.AttributeId, *Ele.ObjectName, *ObjVa, *NetGUID.ToString())
 			if (NetGUID.IsValid()) { continue; }
 		}
-		Object = StaticFindObject(UObject::StaticClass(), Object, *Ele.ObjectName, false);
+		Object = PkgMap->FindObjectByPath_HS(Object, Ele.ObjectName, NetGUID);
+		// outermost static chunk is the package
+		if (!Object && i == 0 && !Ele.HS_NetGUID.IsValid() && OutMissingPackage)
+		{
+			*OutMissingPackage = Ele.ObjectName;
+		}
 		FString ObjVa = Object ? Object->GetName() : FString();
-		PkgMap->AssignNetGUID(NetGUID, Object);
 		UE_LOG(Log_HyperScaleMemory, VeryVerbose, TEXT("Chunk After load is flags: %d HS_NETGUID: %llu AttrId: %d Name: %s  ObjVa: %s	NetGUID:%s"), Ele.ExportFlags, Ele.HS_NetGUID.Get(), Ele.AttributeId, *Ele.ObjectName, *ObjVa, *NetGUID.ToString())
 	}
 }
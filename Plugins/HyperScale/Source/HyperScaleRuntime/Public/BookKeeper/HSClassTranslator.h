@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include "UObject/SoftObjectPath.h"
+
 
 struct FHScaleClassInfoHolder
 {
@@ -32,9 +34,32 @@ private:
 	TMap<uint64, FString> ClassIdPathCache;
 	TMap<FString, uint64> ReverseClassIdPathCache;
 
+	// Packages requested by RequestPackageAsync that are not loaded yet
+	TSet<FString> PendingPackages;
+
+	// Packages that failed to load, they are not requested again
+	TSet<FString> FailedPackages;
+
 	UClass* GetClassFromPath(const FString& Path, const bool bIsStatic);
 
+	uint64 RegisterClassPath(const FSoftClassPath& ClassPath);
+
 public:
+	/**
+	 * Maps class ids of classes known from settings to their paths and starts async loading of the ones not loaded yet,
+	 * so the first entity of such class does not wait for its package
+	 */
+	void WarmUpClassCache();
+
+	/**
+	 * Starts async load of the package if it is not loaded or loading already
+	 * @return true if the package is being loaded, false if it is loaded, invalid or failed to load before
+	 */
+	bool RequestPackageAsync(const FString& PackageName);
+
+	bool IsPackageLoading(const FString& PackageName) const { return PendingPackages.Contains(PackageName); }
+
+	/** Returns the class if it is loaded, otherwise starts its async load and returns nullptr */
 	UClass* GetClass(const uint64 ClassId);
 	uint64 GetClassId(const UClass* Class);
 	FHScaleClassInfoHolder GetClassId(const UObject* Object);
@@ -15,9 +15,19 @@ typedef uint64 HSClassId;
 #define HSCALE_SUBSCRIPTION_LONG_RADIUS 0.8
 #define HSCALE_SUBSCRIPTION_LONG_RADIUS_INTERVAL_MS 600
 
+// Local player position is sent only when it moved at least by this distance (in cm) since the last send
+#define HSCALE_PLAYER_POSITION_SEND_THRESHOLD 5.f
+
 #define HS_EVENT_RADIUS_LOW 0.2f
 #define HS_EVENT_RADIUS_MEDIUM 0.6f
 
+// RPCs are packed into shared event payloads, each one prefixed with its event id (uint16) and size (uint8)
+#define HSCALE_RPC_HEADER_SIZE (sizeof(uint16) + sizeof(uint8))
+#define HSCALE_RPC_MAX_SIZE (QUARK_MAX_PAYLOAD_LEN - HSCALE_RPC_HEADER_SIZE)
+
+// #todo ... this should be cached from schema
+#define MAX_SERVER_RELEVANCY_DISTANCE 2000
+
 #define HYPERSCALE_LEVEL_OPTION TEXT("hscale")
 #define HYPERSCALE_ROLE_OPTION TEXT("Roles")
 
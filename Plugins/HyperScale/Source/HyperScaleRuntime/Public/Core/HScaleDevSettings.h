@@ -59,6 +59,28 @@ protected:
 	UPROPERTY(EditAnywhere, EditFixedSize, Config, Category="Replication Settings")
 	TArray<FHScale_ReplicationClassOptions> ClassesReplicationOptions;
 
+	/** Rpcs without options are multicast in medium radius, reliable only if marked as reliable */
+	UPROPERTY(EditAnywhere, Config, Category="Replication Settings")
+	TArray<FHScale_RPCOptions> RPCOptions;
+
+	/** Classes loaded asynchronously on connection, so entities of these classes are spawned without waiting for load */
+	UPROPERTY(EditAnywhere, Config, Category="Replication Settings")
+	TArray<FSoftClassPath> PreloadClasses;
+
+	/**
+	 * Max time in milliseconds spent per tick in applying server updates to spawned actors, 0 means no limit
+	 * Entities not processed in time are processed in next tick with higher priority
+	 */
+	UPROPERTY(EditAnywhere, Config, Category="Replication Settings", meta = (ClampMin = "0", Units = "ms"))
+	float PullDataBudgetMs = 4.f;
+
 public:
 	static const TArray<FHScale_ReplicationClassOptions>& GetClassesReplicationOptions();
+
+	static const TArray<FSoftClassPath>& GetPreloadClasses();
+
+	static float GetPullDataBudgetMs();
+
+	/** Returns options defined for the rpc, nullptr if there are none */
+	static const FHScale_RPCOptions* FindRPCOptions(const UFunction* Function);
 };
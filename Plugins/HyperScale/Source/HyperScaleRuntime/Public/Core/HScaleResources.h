@@ -36,6 +36,24 @@ enum class EHScale_Lifetime : uint8
 	Detached
 };
 
+UENUM(BlueprintType)
+enum class EHScaleEventRadius : uint8
+{
+	None,
+	Low,
+	Medium,
+	Max,
+};
+
+UENUM(BlueprintType)
+enum class EHScale_EventQos : uint8
+{
+	/** Reliable only if the function is marked as reliable */
+	Default,
+	Reliable,
+	Unreliable
+};
+
 enum EHScale_QuarkEventType : quark_event_class_t
 {
 	//Predefined System Events
@@ -115,6 +133,31 @@ private:
 	uint8 EditorServerActiveIndex;
 };
 
+/**
+ * Defines how the rpc is sent through hyperscale events
+ */
+USTRUCT(BlueprintType)
+struct HYPERSCALERUNTIME_API FHScale_RPCOptions
+{
+	GENERATED_BODY()
+
+	/** Class declaring the rpc, the options are applied to all children classes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TSoftClassPtr<UObject> OwnerClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FName FunctionName;
+
+	/** Radius of recipients for multicast rpc, rpcs sent to single entity ignore it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EHScaleEventRadius Radius = EHScaleEventRadius::Medium;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EHScale_EventQos Qos = EHScale_EventQos::Default;
+
+	bool Matches(const UFunction* Function) const;
+};
+
 enum EHScaleGuidFlags : uint8
 {
 	HSGF_None = 0,
@@ -1,15 +1,44 @@
 ﻿#pragma once
 #include "Core/HScaleResources.h"
+#include "NetworkLayer/HScaleUpdates.h"
 
 class FHScaleNetworkBibliothec;
 class UHScaleConnection;
+class IHScaleNetworkSession;
 
-enum class EHScaleEventRadius
+/** Resolved send options of the rpc */
+struct FHScaleRPCSendOptions
 {
-	None,
-	Low,
-	Medium,
-	Max,
+	EHScaleEventRadius Radius = EHScaleEventRadius::Medium;
+	bool bReliable = true;
+};
+
+/** RPCs for the same recipient packed into one event payload */
+struct FHScaleRPCBatch
+{
+	// class of the first packed rpc, it keeps the whole batch routed as application event
+	quark_event_class_t EventClass = 0;
+	uint8 Data[QUARK_MAX_PAYLOAD_LEN];
+	size_t Size = 0;
+
+	bool IsEmpty() const { return Size == 0; }
+	bool CanAppend(const size_t RPCSize) const { return Size + HSCALE_RPC_HEADER_SIZE + RPCSize <= QUARK_MAX_PAYLOAD_LEN; }
+	void Append(const quark_event_class_t EventId, const uint8* RPCData, const size_t RPCSize);
+	void Reset() { EventClass = 0; Size = 0; }
+};
+
+/** Recipient and qos of the rpc batch, rpcs are packed only while these do not change, so the call order is kept */
+struct FHScaleRPCBatchTarget
+{
+	// invalid for radius recipients
+	FHScaleNetGUID EntityId;
+	EHScaleEventRadius Radius = EHScaleEventRadius::Medium;
+	bool bReliable = true;
+
+	bool operator==(const FHScaleRPCBatchTarget& Other) const
+	{
+		return EntityId == Other.EntityId && Radius == Other.Radius && bReliable == Other.bReliable;
+	}
 };
 
 class HYPERSCALERUNTIME_API FHScaleEventsDriver
@@ -24,10 +53,11 @@ public:
 	void Tick(float DeltaSeconds);
 
 	bool SendObjectDespawnEvent(const FHScaleNetGUID& EntityId) const;
-	bool SendForgetObjectsEvent(const FHScaleNetGUID& EntityId) const;
+	/** Forgotten objects are collected and sent in batches at the end of tick */
+	void MarkEntityForForget(const FHScaleNetGUID& EntityId);
 	bool SendForgetPlayerEvent(const FHScaleNetGUID& EntityId) const;
 	bool SendGetFreeObjectIds(bool ForPlayerObjects = true) const;
-	void HandleEvents(const quark::remote_event& Update);
+	void HandleEvents(const FHScaleRemoteEvent& Update);
 
 	void ProcessLocalRPC(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject);
 
@@ -55,12 +85,12 @@ public:
 	void MarkEntityForToDestroy(const FHScaleNetGUID& EntityId);
 
 private:
-	quark::session* GetNetworkSession() const;
+	IHScaleNetworkSession* GetNetworkSession() const;
 
 	bool SendEvent(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, FBitWriter& Ar) const;
 	bool SendEvent(const quark_event_class_t EventId, const EHScaleEventRadius Radius, FBitWriter& Ar) const;
-	bool SendEvent(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, const uint8* Data = nullptr, const size_t Size = 0) const;
-	bool SendEvent(const quark_event_class_t EventId, const EHScaleEventRadius Radius, const uint8* Data = nullptr, const size_t Size = 0) const;
+	bool SendEvent(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, const uint8* Data = nullptr, const size_t Size = 0, const quark::qos Qos = quark::qos::reliable) const;
+	bool SendEvent(const quark_event_class_t EventId, const EHScaleEventRadius Radius, const uint8* Data = nullptr, const size_t Size = 0, const quark::qos Qos = quark::qos::reliable) const;
 	FHScaleNetworkBibliothec* GetBibliothec() const;
 
 	void SendNetworkDestructionEvents();
@@ -68,18 +98,29 @@ private:
 	void RemoveToDestroyEntities();
 
 	bool SendObjectDespawnEvent(const uint8* Data, const size_t Size) const;
+	bool SendForgetObjectsEvent(const uint8* Data, const size_t Size) const;
+	void SendForgetObjectsEvents();
+
+	/** RPCs are packed together with following RPCs for the same recipient and qos, the batch is sent when they change or at the end of tick */
+	void QueueRPC(const quark_event_class_t EventId, const FHScaleNetGUID& EntityId, const bool bReliable, const FBitWriter& Ar);
+	void QueueRPC(const quark_event_class_t EventId, const EHScaleEventRadius Radius, const bool bReliable, const FBitWriter& Ar);
+	void QueueRPC(const quark_event_class_t EventId, const FHScaleRPCBatchTarget& Target, const FBitWriter& Ar);
+	void SendPendingRPCs();
+
+	/** Options from dev settings are resolved once per function */
+	const FHScaleRPCSendOptions& GetRPCSendOptions(UFunction* Function);
 
-	void HandleDespawnEvent(const quark::remote_event& Update);
-	void HandleApplicationEvents(const quark::remote_event& Update);
-	void HandleDisconnectedEvent(const quark::remote_event& Update);
-	void HandleSystemEvent(const quark::remote_event& Update);
-	void HandleReservedEvent(const quark::remote_event& Update);
+	void HandleDespawnEvent(const FHScaleRemoteEvent& Update);
+	void HandleApplicationEvents(const FHScaleRemoteEvent& Update);
+	void HandleRPC(const uint16 EventId, const uint8* Data, const size_t Size);
+	void HandleDisconnectedEvent(const FHScaleRemoteEvent& Update);
+	void HandleSystemEvent(const FHScaleRemoteEvent& Update);
+	void HandleReservedEvent(const FHScaleRemoteEvent& Update);
 
-	bool ReadRPCParams(::FBitWriter& Writer, ::FBitReader& Reader, const TSharedPtr<FRepLayout>& RepLayout) const;
 	bool WriteRPCParams(::FBitWriter& Writer, ::FBitReader& Reader, const TSharedPtr<FRepLayout>& RepLayout) const;
 	void ProcessRemoteFunctionForChannelPrivate_HS(UActorChannel* Ch, const FClassNetCache* ClassCache,
 		const FFieldNetCache* FieldCache, UObject* TargetObject,
-		UFunction* Function, void* Parameters) const;
+		UFunction* Function, void* Parameters);
 
 	UHScaleConnection* Connection;
 
@@ -88,4 +129,12 @@ private:
 	TSet<FHScaleNetGUID> LocalDestructionEntities;
 
 	TSet<FHScaleNetGUID> ToDestroyEntities;
+
+	TSet<FHScaleNetGUID> ForgetEntities;
+
+	// only the last batch is kept open, rpcs for other recipient or qos flush it first to keep per actor order of rpcs
+	FHScaleRPCBatch PendingRPCs;
+	FHScaleRPCBatchTarget PendingRPCsTarget;
+
+	TMap<TWeakObjectPtr<UFunction>, FHScaleRPCSendOptions> RPCSendOptionsCache;
 };
\ No newline at end of file
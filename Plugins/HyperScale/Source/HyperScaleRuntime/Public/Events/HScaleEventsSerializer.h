@@ -1,23 +1,33 @@
 ﻿#pragma once
 
 class UHScalePackageMap;
+class FRepLayout;
 class FRepLayoutCmd;
 
 class FHScaleEventsSerializer
 {
 public:
+	/** Writes rpc parameters into event payload in single pass, straight from parameters memory */
+	static bool SerializeRPCParams(FBitWriter& Writer, const FRepLayout& RepLayout, const uint8* Parameters, UHScalePackageMap* PkgMap);
+
 	bool static Serialize(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap);
-	
-	bool static ReadObjectPtr(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap);
+
 	bool static WriteObjectPtr(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap);
-	
-	bool static ReadSoftObjectPtr(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap);
 	bool static WriteSoftObjectPtr(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap);
-
-	static bool ReadDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const TArray<FRepLayoutCmd>::ElementType& Cmd);
 	static bool WriteDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const TArray<FRepLayoutCmd>::ElementType& Cmd);
 
 private:
+	static bool SerializeProperty(FBitWriter& Writer, const FRepLayoutCmd& Cmd, const uint8* Data, UHScalePackageMap* PkgMap);
+	static bool SerializeObjectPtr(FBitWriter& Writer, UObject* Object, UHScalePackageMap* PkgMap);
+	static bool SerializeSoftObjectPtr(FBitWriter& Writer, const uint8* Data, UHScalePackageMap* PkgMap);
+	static bool SerializeDynArray(FBitWriter& Writer, const FRepLayoutCmd& Cmd, const FRepLayoutCmd& ElementCmd, const uint8* Data, UHScalePackageMap* PkgMap);
+
+	template<class T>
+	static bool SerializeValue(FBitWriter& Writer, const uint8* Data);
+
+	template<class T>
+	static bool SerializeNetSerializeValue(FBitWriter& Writer, const uint8* Data, UHScalePackageMap* PkgMap);
+
 	template<class T>
 	static bool SerializeDataType(FBitWriter& Writer, FBitReader& Reader);
 
@@ -29,5 +39,5 @@ private:
 	static bool SerializeBoolProperty(FBitWriter& Writer, FBitReader& Reader);
 	static bool SerializeByteProperty(FBitWriter& Writer, FBitReader& Reader, const FRepLayoutCmd& Cmd, UHScalePackageMap* PkgMap);
 
-	static bool SerializeDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const TArray<FRepLayoutCmd>::ElementType& Cmd, const bool bOnSend);
+	static bool SerializeDynArray(FBitWriter& Writer, FBitReader& Reader, UHScalePackageMap* PkgMap, const TArray<FRepLayoutCmd>::ElementType& Cmd);
 };
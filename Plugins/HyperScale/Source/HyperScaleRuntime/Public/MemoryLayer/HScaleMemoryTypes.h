@@ -39,16 +39,24 @@ public:
 
 
 	/**
-	 * Reads the value from 
+	 * Reads the value from network update
+	 * Updates older than the last applied one are dropped, so out of order updates do not flip the value back
+	 * @return false if the update was stale and dropped
 	 */
-	virtual void Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp)
+	virtual bool Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp)
 	{
-		// #TODO: should below statement be enabled?
-		// if (LastUpdatedTs > Timestamp) return;
+		if (IsStaleUpdate(PropertyId, Timestamp)) { return false; }
 		LastUpdatedTs = Timestamp;
 		Deserialize_R(CachedValue, PropertyId);
+		return true;
 	}
 
+	/**
+	 * Returns true if the update is older than the value already held
+	 * Chunks of split properties are separate attributes, possibly from different updates, so they are checked per chunk
+	 */
+	virtual bool IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const { return LastUpdatedTs > Timestamp; }
+
 	virtual void Deserialize_R(const quark::value& CachedValue, const uint16 PropertyId) = 0;
 
 	virtual bool SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd) = 0;
@@ -415,15 +423,60 @@ namespace HScaleTypes
 		virtual void Serialize(TArray<FHScaleAttributesUpdate>& Attributes, uint16 PropertyId) override;
 	};
 
-	class FHScaleSplitStringProperty : public FHScaleProperty
+	/**
+	 * Chunks of a split property stored back to back in a single allocation
+	 * Every chunk slot is [size byte][HSCALE_MAX_BUFFER_LENGTH bytes], dirty bits mark chunks changed since last send,
+	 * received bits mark chunks that hold data received from network
+	 */
+	class FHScaleSplitChunkBuffer
+	{
+	public:
+		static constexpr uint32 ChunkCapacity = HSCALE_MAX_BUFFER_LENGTH;
+		static_assert(HSCALE_MAX_STRING_LENGTH <= ChunkCapacity, "Split string chunks must fit into chunk slot");
+
+		explicit FHScaleSplitChunkBuffer(const uint8 InMaxChunks);
+
+		/** Copies the data into chunk slot, returns true if content of the chunk changed */
+		bool SetChunk(const uint8 Index, const uint8* Data, const uint32 Size);
+		void ClearChunk(const uint8 Index) { Buffer[Index * SlotSize] = 0; }
+
+		const uint8* GetChunkData(const uint8 Index) const { return Buffer.data() + Index * SlotSize + 1; }
+		uint8 GetChunkSize(const uint8 Index) const { return Buffer[Index * SlotSize]; }
+		uint8 GetChunkLastByte(const uint8 Index) const { return GetChunkData(Index)[GetChunkSize(Index) - 1]; }
+
+		bool IsDirty(const uint8 Index) const { return (DirtyBits >> Index) & 1; }
+		void MarkDirty(const uint8 Index) { DirtyBits |= 1u << Index; }
+		void ClearDirty() { DirtyBits = 0; }
+
+		bool IsReceived(const uint8 Index) const { return (ReceivedBits >> Index) & 1; }
+		void MarkReceived(const uint8 Index) { ReceivedBits |= 1u << Index; }
+		void ClearReceived() { ReceivedBits = 0; }
+
+		/** Timestamp of the last update received for the chunk, kept when received bits are cleared */
+		uint64 GetChunkTimestamp(const uint8 Index) const { return Timestamps[Index]; }
+		void SetChunkTimestamp(const uint8 Index, const uint64 Timestamp) { Timestamps[Index] = Timestamp; }
+
+		uint8 Num() const { return MaxChunks; }
+
+	private:
+		static constexpr uint32 SlotSize = ChunkCapacity + 1;
+
+		std::vector<uint8> Buffer;
+		TArray<uint64, TInlineAllocator<HS_SPLIT_PROPERTY_MAX_LENGTH>> Timestamps;
+		uint8 MaxChunks;
+		uint32 DirtyBits = 0;
+		uint32 ReceivedBits = 0;
+	};
+
+	class HYPERSCALERUNTIME_API FHScaleSplitStringProperty : public FHScaleProperty
 	{
 		OVERRIDE_HSCALE_TYPE(EHScaleMemoryTypeId::SplitString)
 
 		FHScaleSplitStringProperty(const uint8_t MaxLength);
 
 		virtual void Serialize(TArray<FHScaleAttributesUpdate>& Attributes, uint16 PropertyId) override;
-		virtual void Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp) override;
 		virtual void Deserialize_R(const quark::value& CachedValue, const uint16 PropertyId) override;
+		virtual bool IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const override;
 		virtual bool SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd) override;
 		virtual bool SerializeFString(FArchive& Ar);
 		virtual FString ToDebugString() override { return FullStringValue; }
@@ -440,7 +493,7 @@ namespace HScaleTypes
 		bool UpdateSplitStringFromFullString();
 
 		uint8 MaxLength;
-		std::vector<std::unique_ptr<FHScaleProperty>> SplitStrings;
+		FHScaleSplitChunkBuffer Chunks;
 		FString FullStringValue;
 		uint8 Count;
 	};
@@ -452,8 +505,8 @@ namespace HScaleTypes
 		FHScaleSplitByteProperty(const uint8_t MaxLength);
 
 		virtual void Serialize(TArray<FHScaleAttributesUpdate>& Attributes, uint16 PropertyId) override;
-		virtual void Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp) override;
 		virtual void Deserialize_R(const quark::value& Value, const uint16 PropertyId) override;
+		virtual bool IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const override;
 		virtual bool SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd) override;
 		virtual FString ToDebugString() override;
 
@@ -464,11 +517,15 @@ namespace HScaleTypes
 		virtual bool IsCompleteForReceive() const override;
 
 	protected:
+		virtual uint8 GetChunkIndex(const uint16 PropertyId) const;
 		bool UpdateSplitBytesFromFullBytes();
+		/** Replaces full buffer and re-splits it, returns false if the buffer did not change */
+		bool SetFullBytes(const uint8* Data, const int64 Num);
+		void SerializeChunks(TArray<FHScaleAttributesUpdate>& Attributes, const uint16 Offset, const bool bOnlyDirty);
 		virtual void DeserializeForIndex(const quark::value& Value, uint16 PropertyId, uint8 Index);
 		uint8 MaxLength;
-		// #todo: instead of uniqueptrs, directly can keep fixed number of properties in memory
-		std::vector<std::unique_ptr<FHScaleProperty>> SplitBytes;
+		// every chunk ends with hash id of its split, so the whole split is dirty after re-split
+		FHScaleSplitChunkBuffer Chunks;
 		std::vector<uint8> FullBuffer;
 		uint8 Count;
 		uint8 OnReceiveHashID = UINT8_MAX;
@@ -484,6 +541,7 @@ namespace HScaleTypes
 		virtual void Serialize(TArray<FHScaleAttributesUpdate>& Attributes, uint16 PropertyId) override;
 		virtual void Deserialize_R(const quark::value& Value, const uint16 PropertyId) override;
 		virtual bool SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd) override;
+		virtual uint8 GetChunkIndex(const uint16 PropertyId) const override;
 		void SerializeChunk(FHScaleOuterChunk& Chunk, FHScaleOuterChunk* NextChunk, const uint8 CurIndex, const uint16 PropertyId);
 		void Clear();
 
@@ -501,8 +559,8 @@ namespace HScaleTypes
 		FHScaleObjectDataProperty(const uint8 MaxLength);
 
 		virtual void Serialize(TArray<FHScaleAttributesUpdate>& Attributes, uint16 PropertyId) override;
-		virtual void Deserialize(const quark::value& CachedValue, const uint16 PropertyId, const uint64 Timestamp) override;
 		virtual void Deserialize_R(const quark::value& Value, const uint16 PropertyId) override;
+		virtual bool IsStaleUpdate(const uint16 PropertyId, const uint64 Timestamp) const override;
 		virtual FString ToDebugString() override;
 		virtual bool SerializeUE(FArchive& Ar, const FRepLayoutCmd& Cmd) override;
 
@@ -517,6 +575,9 @@ namespace HScaleTypes
 		FNetworkGUID NetworkGUID;
 		FHScaleNetGUID HScaleNetGUID;
 
+		// Object loaded from paths only, without dynamic outers, reset when the property changes
+		TWeakObjectPtr<UObject> ResolvedStaticObject;
+
 	protected:
 		uint8 MaxLength;
 		std::vector<std::unique_ptr<FHScaleProperty>> SplitChunks;
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "HScaleNetworkEntity.h"
+#include "HScaleSpatialGrid.h"
 #include "remote.h"
 
 // #todo the log category value should be a macro, defined from plugin .cs file
@@ -25,7 +26,8 @@ class HYPERSCALERUNTIME_API FHScaleNetworkBibliothec
 {
 public:
 	FHScaleNetworkBibliothec()
-		: NetDriver(nullptr) {}
+		: NetDriver(nullptr)
+		, ActorEntitiesGrid(MAX_SERVER_RELEVANCY_DISTANCE) {}
 
 	~FHScaleNetworkBibliothec() {}
 
@@ -88,8 +90,22 @@ public:
 
 	void DestroyEntity(const FHScaleNetGUID& EntityId);
 
-	void HandlePlayersNetworkUpdate(const quark::remote_player_update& Update);
-	void HandleObjectsNetworkUpdate(const quark::remote_object_update& Update);
+	/**
+	 * Collects actor entities whose last known location can be within Radius of Center
+	 * Result is not distance filtered, it only narrows down the candidates
+	 */
+	void QueryActorEntitiesInRadius(const FVector& Center, const float Radius, TArray<FHScaleNetGUID>& OutEntities) const;
+
+	void HandlePlayersNetworkUpdate(const quark_player_id_t RemotePlayerId, const quark_attribute_id_t AttributeId, const quark::value& Value, const quark_timestamp_t Timestamp);
+	void HandleObjectsNetworkUpdate(const quark_object_id_t RemoteObjectId, const quark_attribute_id_t AttributeId, const quark::value& Value, const quark_timestamp_t Timestamp);
+
+	/** Number of received attribute updates dropped as older than the value already held */
+	uint64 NumDroppedStaleUpdates() const { return DroppedStaleUpdates; }
+
+	void AddEntityPendingClassLoad(const FHScaleNetGUID& EntityId);
+
+	/** Retries entities waiting for async load of their archetype package, ready ones are marked server dirty */
+	void ResolvePendingClassLoads();
 	
 protected:
 	void Push(FHScaleInBunch& Bunch, const FHScaleNetGUID ObjectId);
@@ -104,11 +120,22 @@ protected:
 	// List of entities changed locally, yet to push to server
 	TSet<FHScaleNetGUID> LocalDirtyEntities;
 
+	// Back buffer of LocalDirtyEntities, used only while pulling local changes
+	TSet<FHScaleNetGUID> PulledLocalDirtyEntities;
+
 	// List of entities received update from server, yet to push to replication layer
 	TSet<FHScaleNetGUID> ServerDirtyEntities;
 
+	// Entities not initialized until their archetype package is loaded asynchronously
+	TSet<FHScaleNetGUID> EntitiesPendingClassLoad;
+
 	uint64 PlayerClassId = 0;
 
+	uint64 DroppedStaleUpdates = 0;
+
+	// Position of local player that was last sent to server
+	TOptional<FVector> LastSentPlayerLocation;
+
 	// #todo make this method available to only to replication layer through friend keyword
 	void SetPlayerClassId(const uint64 ClassId);
 
@@ -117,7 +144,13 @@ protected:
 
 	bool Pull(FInBunch& Bunch, const FHScaleNetGUID ObjectId, const bool bDelta = true);
 
+	/** Keeps the entity cell in ActorEntitiesGrid in sync with its position property */
+	void UpdateEntityLocation(const FHScaleNetworkEntity* Entity);
+
 	UHScaleNetDriver* NetDriver;
 
 	TSet<FHScaleNetGUID> EntityPerFlags[16]; // hardcoding to 16, as it is the max number of flags possible
+
+	// Actor entities with known location, bucketed by MAX_SERVER_RELEVANCY_DISTANCE sized cells
+	FHScaleSpatialGrid ActorEntitiesGrid;
 };
\ No newline at end of file
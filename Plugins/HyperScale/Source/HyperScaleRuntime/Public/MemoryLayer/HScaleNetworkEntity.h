@@ -4,7 +4,6 @@
 
 #include "CoreMinimal.h"
 
-#include <map>
 #include <memory>
 
 #include "Core/HScaleResources.h"
@@ -91,8 +90,8 @@ public:
 
 private:
 	// All properties for entity are stored in this map. This map should be unique owner for properties
-	// memory lifetime
-	std::map<uint16, std::unique_ptr<FHScaleProperty>> Properties;
+	// memory lifetime. Kept sorted by property id, which is also the order properties are written out in
+	THScaleFlatMap<uint16, std::unique_ptr<FHScaleProperty>> Properties;
 
 	// List of property ids that are changed locally, yet to pushed to server 
 	TSet<uint16> LocalDirtyProps;
@@ -110,6 +109,25 @@ private:
 	// Unreal class pointer of the current entity
 	UClass* Clazz;
 
+	// Number of received updates dropped because they were older than the property value
+	uint32 DroppedStaleUpdates = 0;
+
+	// Package of the archetype that is loaded asynchronously, entity is not initialized until it is loaded
+	FString PendingClassPackage;
+
+	// Rep layout resolved for ClassId on first pull, shared with net driver
+	struct FHScaleCachedRepLayout
+	{
+		uint64 ClassId = 0;
+		TWeakObjectPtr<UClass> Class;
+		TSharedPtr<FRepLayout> RepLayout;
+		const TArray<uint16>* HandleToCmdIndex = nullptr;
+	};
+
+	mutable FHScaleCachedRepLayout CachedRepLayout;
+
+	const FHScaleCachedRepLayout& FetchCachedRepLayout(UClass* ObjectClass) const;
+
 	// Finds the property from cache if exists, or creates a property with given value type 
 	FHScaleProperty* FetchPropertyOnReceive(const uint16 PropertyId, const quark::value& CachedValue);
 
@@ -126,7 +144,7 @@ private:
 
 	void HandleArchetypeUpdate(HScaleTypes::FHScaleObjectDataProperty* Property);
 
-	void LoadObjectPtrData(HScaleTypes::FHScaleObjectDataProperty* Property, UObject*& Object) const;
+	void LoadObjectPtrData(HScaleTypes::FHScaleObjectDataProperty* Property, UObject*& Object, FString* OutMissingPackage = nullptr) const;
 
 	bool IsHeadersValid() const;
 
@@ -158,7 +176,8 @@ private:
 
 	UHScaleConnection* GetNetConnection() const;
 
-	void CheckAndUpdateOwner(const TArray<FRepParentCmd>& ParentCmds, const FRepLayoutCmd& RepCmd, FHScaleProperty* Property);
+	/** Updates entity owner from replicated AActor::Owner property */
+	void UpdateOwnerFromProperty(FHScaleProperty* Property);
 
 	bool SerializeObjectFromBunch(FBitReader& Ar, FHScaleProperty* Property, uint16 PropertyId);
 
@@ -208,6 +227,8 @@ public:
 
 	int32 NumServerDirtyProps() const;
 
+	uint32 NumDroppedStaleUpdates() const { return DroppedStaleUpdates; }
+
 	bool IsPlayer() const { return EntityId.IsValid() && EntityId.IsPlayer(); }
 
 	bool IsStatic() const { return EntityId.IsStatic(); }
@@ -226,8 +247,9 @@ public:
 	/**
 	 * Read from supplied network reader, and update properties locally.
 	 * All properties updated locally are marked as server dirty
+	 * @return false if the update is older than the last applied one and was dropped
 	 */
-	void Push(const uint16_t PropertyId, const quark::value& Value, const uint64 Timestamp);
+	bool Push(const uint16_t PropertyId, const quark::value& Value, const uint64 Timestamp);
 
 	void PushPlayerOwnedUpdate(const uint16_t Key, const quark::value& Value, const uint64 Timestamp);
 
@@ -294,6 +316,12 @@ public:
 	 */
 	void CheckAndReviseStates();
 
+	/**
+	 * Resolves the archetype again when its package finished loading
+	 * @return true if the entity no longer waits for any package
+	 */
+	bool RetryPendingClassLoad();
+
 	void PrintHeaders() const;
 
 
@@ -319,13 +347,15 @@ private:
 class FHScaleRepCmdIterator
 {
 public:
-	FHScaleRepCmdIterator(const TArray<FRepLayoutCmd>* Cmds)
-		: CurIndex(0), Cmds(Cmds) {}
+	FHScaleRepCmdIterator(const TArray<FRepLayoutCmd>* Cmds, const TArray<uint16>* HandleToCmdIndex)
+		: CurIndex(0), Cmds(Cmds), HandleToCmdIndex(HandleToCmdIndex) {}
 
+	/** Finds top level cmd of the handle, see UHScaleNetDriver::GetHandleToCmdIndexTable */
 	uint16 FetchCmdIndex(const uint16 PropertyHandle);
 
 	uint16 FetchNextIndex();
 
 	uint16 CurIndex;
 	const TArray<FRepLayoutCmd>* Cmds;
+	const TArray<uint16>* HandleToCmdIndex;
 };
\ No newline at end of file
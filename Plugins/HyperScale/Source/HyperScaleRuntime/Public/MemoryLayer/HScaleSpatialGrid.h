@@ -0,0 +1,45 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Core/HScaleResources.h"
+
+/**
+ * Uniform grid of entity ids bucketed by their last known location
+ * Used to answer "which entities are around this point" without walking all network entities
+ */
+class HYPERSCALERUNTIME_API FHScaleSpatialGrid
+{
+public:
+	explicit FHScaleSpatialGrid(const float InCellSize)
+		: CellSize(InCellSize) { check(CellSize > 0.f) }
+
+	/** Inserts the entity or moves it to the cell containing Location */
+	void Update(const FHScaleNetGUID& EntityId, const FVector& Location);
+
+	void Remove(const FHScaleNetGUID& EntityId);
+
+	/**
+	 * Gathers entities from all cells overlapping the sphere bounds
+	 * Result is a superset, callers still have to do their own exact distance checks
+	 */
+	void Query(const FVector& Center, const float Radius, TArray<FHScaleNetGUID>& OutEntities) const;
+
+	bool Contains(const FHScaleNetGUID& EntityId) const { return EntityCells.Contains(EntityId); }
+
+	int32 Num() const { return EntityCells.Num(); }
+
+	void Empty();
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	float CellSize;
+
+	TMap<FIntVector, TSet<FHScaleNetGUID>> Cells;
+
+	// Reverse lookup, so moving or removing an entity does not need to search cells
+	TMap<FHScaleNetGUID, FIntVector> EntityCells;
+};
@@ -16,32 +16,65 @@ class UHScaleRelevancyManager;
 
 DECLARE_DELEGATE_RetVal(bool, FOnLowItemCountSignature);
 
-class TGUID_Cache : protected TDoubleLinkedList<uint64_t>
+/**
+ * Pool of object ids issued by server, stored in contiguous ring buffer
+ *
+ * The pool is refilled before it drains, the target size follows observed consumption rate
+ * and the time server needs to answer the request, so bursts of spawns do not wait for a round trip
+ */
+class TGUID_Cache
 {
+	static constexpr int32 MaxTargetCount = 32 * QUARK_MAX_SEQUENCE_LENGTH;
+	static constexpr double RateSampleInterval = 0.5;
+	static constexpr double RequestTimeout = 2.0;
+
 	int32 LowItemThreshold = QUARK_MAX_SEQUENCE_LENGTH;
 
 public:
 	bool Enqueue(const uint64_t& Item)
 	{
-		bool success = AddHead(Item);
-		if (success) bNewItemsRequested = false;
+		if (Count == Buffer.Num())
+		{
+			Grow();
+		}
 
-		return success;
+		Buffer[(Head + Count) & (Buffer.Num() - 1)] = Item;
+		++Count;
+		return true;
+	}
+
+	/** Adds ids received in one response to request for new items */
+	void EnqueueResponse(const uint64_t* Items, const int32 NumItems)
+	{
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			Enqueue(Items[i]);
+		}
+
+		if (NumPendingRequests > 0)
+		{
+			--NumPendingRequests;
+			const double RoundTrip = FPlatformTime::Seconds() - LastRequestTime;
+			AverageRoundTrip = AverageRoundTrip > 0.0 ? FMath::Lerp(AverageRoundTrip, RoundTrip, 0.25) : RoundTrip;
+		}
+		RequestNewItems();
 	}
 
 	bool Dequeue(uint64_t& Item)
 	{
-		TDoubleLinkedList<uint64_t>::TDoubleLinkedListNode *tail = GetTail();
-		if (!tail)
+		if (Count == 0)
 		{
 			RequestNewItems();
 			Item = 0ull;
 			return false;
 		}
 
-		Item = tail->GetValue();
-		RemoveNode(tail);
+		Item = Buffer[Head];
+		Head = (Head + 1) & (Buffer.Num() - 1);
+		--Count;
 
+		++NumDequeuedInSample;
+		RequestNewItems();
 		return true;
 	}
 
@@ -52,8 +85,15 @@ public:
 		RequestNewItems();
 	}
 
-	int32 Num() const { return TDoubleLinkedList::Num(); }
-	bool IsEmpty() const { return TDoubleLinkedList::IsEmpty(); }
+	int32 Num() const { return Count; }
+	bool IsEmpty() const { return Count == 0; }
+
+	/** Number of ids the pool tries to keep, never less than low item threshold */
+	int32 GetTargetCount() const
+	{
+		const int32 PrefetchCount = FMath::CeilToInt32(ConsumptionRate * AverageRoundTrip * 2.0);
+		return FMath::Max(LowItemThreshold, FMath::Min(PrefetchCount, MaxTargetCount));
+	}
 
 	template<typename FunctorType>
 	void BindOnLowItemCountDelegate(FunctorType&& Func)
@@ -62,45 +102,77 @@ public:
 		RequestNewItems();
 	}
 
-protected:
-	virtual void SetListSize(int32 NewListSize) override
+private:
+	void Grow()
 	{
-		int32 OldListSize = Num();
-		TDoubleLinkedList::SetListSize(NewListSize);
-		if (NewListSize <= OldListSize)
+		// capacity is kept power of two, so wrapping is just a mask
+		TArray<uint64_t> NewBuffer;
+		NewBuffer.SetNumUninitialized(FMath::Max(QUARK_MAX_SEQUENCE_LENGTH, Buffer.Num() * 2));
+		for (int32 i = 0; i < Count; ++i)
 		{
-			RequestNewItems();
+			NewBuffer[i] = Buffer[(Head + i) & (Buffer.Num() - 1)];
 		}
+		Buffer = MoveTemp(NewBuffer);
+		Head = 0;
 	}
 
-private:
-	bool bNewItemsRequested = false;
+	void UpdateConsumptionRate(const double Now)
+	{
+		const double Elapsed = Now - SampleStartTime;
+		if (Elapsed < RateSampleInterval) return;
+
+		const double SampleRate = SampleStartTime > 0.0 ? NumDequeuedInSample / Elapsed : 0.0;
+		ConsumptionRate = FMath::Lerp(ConsumptionRate, SampleRate, 0.5);
+		NumDequeuedInSample = 0;
+		SampleStartTime = Now;
+	}
 
 	bool RequestNewItems()
 	{
-		if ((Num() >= LowItemThreshold) || bNewItemsRequested || !OnLowItemCount.IsBound())
+		if (!OnLowItemCount.IsBound()) return false;
+
+		const double Now = FPlatformTime::Seconds();
+		UpdateConsumptionRate(Now);
+
+		// lost responses would block the pool forever
+		if (NumPendingRequests > 0 && Now - LastRequestTime > RequestTimeout)
 		{
-			return false;
+			NumPendingRequests = 0;
 		}
 
-		int32 requestCount = (LowItemThreshold - Num() - 1) / QUARK_MAX_SEQUENCE_LENGTH + 1;
+		const int32 ExpectedCount = Count + NumPendingRequests * QUARK_MAX_SEQUENCE_LENGTH;
+		const int32 TargetCount = GetTargetCount();
+		if (ExpectedCount >= TargetCount) return false;
 
-		for (int32 i = 0; i < requestCount; ++i)
+		const int32 RequestCount = (TargetCount - ExpectedCount - 1) / QUARK_MAX_SEQUENCE_LENGTH + 1;
+		for (int32 i = 0; i < RequestCount; ++i)
 		{
 			if (!OnLowItemCount.Execute()) return false;
+
+			++NumPendingRequests;
+			LastRequestTime = Now;
 		}
 
-		bNewItemsRequested = true;
 		return true;
 	}
 
+	TArray<uint64_t> Buffer;
+	int32 Head = 0;
+	int32 Count = 0;
+
+	int32 NumPendingRequests = 0;
+	double LastRequestTime = 0.0;
+	double AverageRoundTrip = 0.0;
+
+	/** Ids consumed per second, smoothed over samples */
+	double ConsumptionRate = 0.0;
+	double SampleStartTime = 0.0;
+	int32 NumDequeuedInSample = 0;
+
 	FOnLowItemCountSignature OnLowItemCount;
 };
 
-namespace quark
-{
-	class session;
-}
+class IHScaleNetworkSession;
 
 /**
  * The class will establish a new connection with hyperscale server and handling
@@ -138,10 +210,18 @@ public:
 	 */
 	virtual bool InitHyperScaleConnection();
 
+	/**
+	 * Creates the transport to hyperscale server, by default a quark session to the server from URL
+	 * Can be overridden to run the connection against a different session implementation, e.g. in tests
+	 *
+	 * @return - Created session, or nullptr if the session could not be started
+	 */
+	virtual TUniquePtr<IHScaleNetworkSession> CreateNetworkSession();
+
 	virtual void TryReceiveData() {}
 
 	/** Returns established network session with hyperscale server */
-	quark::session* GetNetworkSession() const { return NetworkSession.Get(); }
+	IHScaleNetworkSession* GetNetworkSession() const { return NetworkSession.Get(); }
 
 	quark_session_id_t GetNetworkSessionId() const;
 
@@ -176,7 +256,7 @@ private:
 	 * Stored server session from function InitHyperScaleConnection()
 	 * The session is responsible for synchronization with hyperscale server
 	 */
-	TUniquePtr<quark::session> NetworkSession;
+	TUniquePtr<IHScaleNetworkSession> NetworkSession;
 
 	TUniquePtr<FHScaleEventsDriver> EventsDriver;
 
@@ -192,13 +272,26 @@ private:
 public:
 	int32 GetOrCreateChannelIndexForEntity(FHScaleNetworkEntity* Entity);
 
+	/** Returns channel index back to allocator, called when actor channel is cleaned up */
+	void ReleaseChannelIndex(const int32 ChIndex);
+
 	void PullUnmappedEntityUpdate(const FHScaleNetGUID& EntityId);
 
 private:
 	void PullDataFromMemoryLayer();
 
 	int32 GetFreeChannelIndex(const FName& ChName);
+	int32 FindAndReserveChannelIndex(const int32 FirstChannel);
+	void RebuildReservedChannelIndices();
 
+	/**
+	 * Channel indices in use or handed out to entities that are about to open their channel
+	 * Channels opened by engine are not tracked, they are marked when allocator runs into them
+	 */
+	TBitArray<> ReservedChannelIndices;
 
 	TMap<FHScaleNetGUID, TSet<TTuple<FHScaleNetGUID, uint16>>> UnMappedObjPtrs;
+
+	/** Number of ticks the server dirty entities were left over by PullDataFromMemoryLayer because of its budget */
+	TMap<FHScaleNetGUID, uint32> DeferredPullTicks;
 };
\ No newline at end of file
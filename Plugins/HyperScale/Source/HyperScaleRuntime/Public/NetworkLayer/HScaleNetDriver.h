@@ -43,6 +43,9 @@ public:
 	virtual FNetworkGUID GetGUIDForActor(const AActor* InActor) const { return FNetworkGUID(); }
 	//virtual void PostTickFlush() override {}
 
+	virtual void AddClientConnection(UNetConnection* NewConnection) override;
+	virtual void RemoveClientConnection(UNetConnection* ClientConnectionToRemove) override;
+
 	/**
 	* Helper functions for ServerReplicateActors
 	* Originally they have parent ones starting with "Server..." but they are only declared WITH_Server
@@ -59,7 +62,7 @@ public:
 	virtual bool IsNetworkSessionActive() const;
 
 	FHScaleNetworkBibliothec* GetBibliothec() const { return Bibliothec.Get(); }
-	UHScaleConnection* GetHyperScaleConnection() const;
+	UHScaleConnection* GetHyperScaleConnection() const { return HyperScaleConnection.Get(); }
 
 public:
 	/** @warning - Be carefully with this, it should be changed to true only when replication is happening from server */
@@ -69,6 +72,18 @@ public:
 
 	TSharedPtr<FRepLayout> GetObjectClassRepLayout_Copy(UClass* InClass);
 
+	/**
+	 * Returns cmd index of top level AActor::Owner property in RepLayout of the class,
+	 * resolved once per class, INDEX_NONE if the class does not replicate the owner
+	 */
+	int32 GetOwnerCmdIndex(UClass* InClass, const FRepLayout& RepLayout);
+
+	/**
+	 * Returns table of top level property handles to cmd indices in RepLayout of the class, built once per class
+	 * Table address is stable, so it can be cached by callers
+	 */
+	const TArray<uint16>& GetHandleToCmdIndexTable(UClass* InClass, const FRepLayout& RepLayout);
+
 	virtual void ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject) override;
 private:
 	float DeltaReplication = 0.f;
@@ -85,6 +100,13 @@ private:
 	 */
 	TUniquePtr<FHScaleNetworkBibliothec> Bibliothec;
 
+	TMap<TWeakObjectPtr<UClass>, int32> OwnerCmdIndexMap;
+
+	TMap<TWeakObjectPtr<UClass>, TUniquePtr<TArray<uint16>>> HandleToCmdIndexMap;
+
+	/** Cached from ClientConnections, the connection is owned by the list */
+	TWeakObjectPtr<UHScaleConnection> HyperScaleConnection;
+
 	// UPROPERTY()
 	// TObjectPtr<UHScaleReplicationLayer> ReplicationLayer;
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "quark.h"
+
+struct FHScaleLocalUpdate;
+class FHScaleNetworkBibliothec;
+class FHScaleEventsDriver;
+
+/**
+ * Transport used by UHScaleConnection to exchange updates with hyperscale server
+ *
+ * FHScaleQuarkSession is the implementation used in game, other implementations can be provided
+ * through UHScaleConnection::CreateNetworkSession(), e.g. in-process sessions for tests and benchmarks
+ */
+class HYPERSCALERUNTIME_API IHScaleNetworkSession
+{
+public:
+	virtual ~IHScaleNetworkSession() {}
+
+	/** Schedules all attributes of the update for sending, returns false if any of them was rejected */
+	virtual bool Send(const FHScaleLocalUpdate& Update) = 0;
+
+	virtual bool SendEvent(const quark_event_class_t EventClass, const quark::recipient& Recipient, const uint8* Data, const size_t Size, const quark::qos Qos) = 0;
+
+	virtual bool Subscribe(const quark::query& Query, const quark::qos Qos) = 0;
+
+	/** Drains all pending remote updates and dispatches them to memory layer and events driver */
+	virtual void Receive(FHScaleNetworkBibliothec& Bibliothec, FHScaleEventsDriver& EventsDriver) = 0;
+
+	virtual quark_session_id_t GetId() const = 0;
+};
+
+/**
+ * Network session backed by quark SDK
+ */
+class HYPERSCALERUNTIME_API FHScaleQuarkSession : public IHScaleNetworkSession
+{
+public:
+	explicit FHScaleQuarkSession(quark::session&& InSession)
+		: Session(MoveTemp(InSession)) {}
+
+	virtual bool Send(const FHScaleLocalUpdate& Update) override;
+	virtual bool SendEvent(const quark_event_class_t EventClass, const quark::recipient& Recipient, const uint8* Data, const size_t Size, const quark::qos Qos) override;
+	virtual bool Subscribe(const quark::query& Query, const quark::qos Qos) override;
+	virtual void Receive(FHScaleNetworkBibliothec& Bibliothec, FHScaleEventsDriver& EventsDriver) override;
+	virtual quark_session_id_t GetId() const override;
+
+private:
+	quark::session Session;
+};
@@ -10,6 +10,23 @@
 
 class FHScaleNetworkEntity;
 class UHScaleConnection;
+
+/** Outer and name of an object, as they are sent in outer chunks of object references */
+struct FHScaleObjectPathKey
+{
+	FObjectKey Outer;
+	FString Name;
+
+	bool operator==(const FHScaleObjectPathKey& Other) const { return Outer == Other.Outer && Name == Other.Name; }
+
+	friend uint32 GetTypeHash(const FHScaleObjectPathKey& Key) { return HashCombine(GetTypeHash(Key.Outer), GetTypeHash(Key.Name)); }
+};
+
+struct FHScaleCachedObjectPath
+{
+	TWeakObjectPtr<UObject> Object;
+	FNetworkGUID NetGUID;
+};
 /**
  * 
  */
@@ -51,6 +68,12 @@ public:
 
 	void CleanUpObjectGuid(const FNetworkGUID NetGUID);
 
+	/**
+	 * Finds object by its name within outer and assigns its NetGUID
+	 * Resolved objects are cached, so static level actors and assets are not searched by StaticFindObject on every reference
+	 */
+	UObject* FindObjectByPath_HS(UObject* Outer, const FString& ObjectName, FNetworkGUID& OutNetGUID);
+
 protected:
 	virtual void PreRemoteActorSpawn(AActor* InActor);
 
@@ -64,4 +87,9 @@ protected:
 	TMap<FNetworkGUID, FHScaleNetGUID> ObjectGuidMapToNetGuid;
 	/** The opposite to the ObjectGuidMapToNetGuid */
 	TMap<FHScaleNetGUID, FNetworkGUID> NetGuidMapToObjectGuid;
+
+	/** Objects resolved by FindObjectByPath_HS, destroyed objects are dropped on next lookup */
+	TMap<FHScaleObjectPathKey, FHScaleCachedObjectPath> ObjectPathCache;
+	/** Keys of ObjectPathCache by NetGUID, to drop entries when NetGUID is cleaned up */
+	TMap<FNetworkGUID, FHScaleObjectPathKey> ObjectPathCacheKeys;
 };
\ No newline at end of file
@@ -14,4 +14,16 @@ struct FHScaleLocalUpdate
 	bool bIsPlayer;
 	quark_object_id_t ObjectId;
 	TArray<FHScaleAttributesUpdate> Attributes;
-};
\ No newline at end of file
+};
+
+/**
+ * View over a received event payload, decoupled from quark::remote_event so events can also be
+ * dispatched from sub ranges of a payload or from non quark sessions
+ */
+struct FHScaleRemoteEvent
+{
+	quark_event_class_t EventClass = 0;
+	const uint8* Data = nullptr;
+	size_t Size = 0;
+	bool bFromPlayer = false;
+};
@@ -8,9 +8,6 @@
 
 #include "HScaleRelevancyManager.generated.h"
 
-// #todo ... this should be cached from schema
-#define MAX_SERVER_RELEVANCY_DISTANCE 2000
-
 class UHScaleRepDriver;
 class FHScaleNetworkBibliothec;
 class FHScaleNetworkEntity;
@@ -27,6 +24,23 @@ enum class EHScale_EntityState
 	Irrelevant
 };
 
+/** Scheduled dormancy check of an entity, ordered by check time */
+struct FHScaleDormancyEntry
+{
+	FHScaleNetGUID NetGUID;
+	double CheckTime;
+
+	bool operator<(const FHScaleDormancyEntry& Other) const { return CheckTime < Other.CheckTime; }
+};
+
+struct FHScaleDormancyState
+{
+	double LastRelevantTime = 0.0;
+
+	/** Only the queued entry with this time is valid, older ones are skipped when popped */
+	double ScheduledCheckTime = 0.0;
+};
+
 UCLASS()
 class UHScaleRelevancyManager : public UObject, public FTickableGameObject
 {
@@ -38,8 +52,13 @@ public:
 	static UHScaleRelevancyManager* Create(UHScaleConnection* NetConnection);
 
 	float RelevancyCheckPeriod{0.05f};
+
+	/** How long an entity has to be out of server relevancy distance before it is flushed */
 	float DormancyCheckPeriod{50.f};
 
+	/** Max time spent in processing of expired dormancy entries per tick */
+	float DormancyCheckBudget{0.0005f};
+
 protected:
 	virtual void Initialize(UHScaleConnection* NetConnection);
 
@@ -55,9 +74,17 @@ public:
 
 	void ClearEntity(const FHScaleNetGUID NetGUID);
 
+	/** Schedules dormancy checks for the actor entity, nothing happens if it is already tracked */
+	void TrackEntityDormancy(const FHScaleNetGUID NetGUID);
+
 private:
 	void CheckRelevancy_Internal(const FHScaleNetGUID& NetGUID, UHScaleRepDriver& RepDriver, FHScaleNetworkBibliothec& Bibliothec);
 
+	/** Entity is (server) relevant now, its dormancy countdown starts from beginning */
+	void MarkEntityRelevantForDormancy(const FHScaleNetGUID NetGUID);
+
+	void ScheduleDormancyCheck(const FHScaleNetGUID NetGUID, FHScaleDormancyState& State, const double CheckTime);
+
 public:
 	bool IsActorNetRelevantToPlayer(const FHScaleNetGUID NetGUID) const;
 	bool IsEntityServerRelevantToPlayer(const TSharedPtr<FHScaleNetworkEntity> NetworkEntity) const;
@@ -66,11 +93,21 @@ public:
 protected:
 	TSet<FHScaleNetGUID> EntitiesInDestructionMode;
 	TSet<FHScaleNetGUID> RelevantEntities;
-	TSet<FHScaleNetGUID> EntitiesInDormantState;
+
+	/** Tracked actor entities, they are flushed after DormancyCheckPeriod without being relevant */
+	TMap<FHScaleNetGUID, FHScaleDormancyState> DormancyStates;
+
+	/** Heap of pending dormancy checks */
+	TArray<FHScaleDormancyEntry> DormancyQueue;
 
 private:
 	float CurrentRelevancyDeltaTime{0.f};
-	float CurrentDormancyDeltaTime{0.f};
+
+	/** Time accumulated from ticks, used as a clock for dormancy checks */
+	double CurrentDormancyTime{0.0};
+
+	/** Scratch list of grid query results, kept to avoid reallocation on each relevancy check */
+	TArray<FHScaleNetGUID> RelevancyCandidates;
 
 	/** Cached net driver from Initialize() function */
 	UPROPERTY()
@@ -41,15 +41,15 @@ public:
 
 	virtual void RemoveNetworkActor(AActor* Actor) override;
 
-	virtual void ForceNetUpdate(AActor* Actor) override {}
+	virtual void ForceNetUpdate(AActor* Actor) override;
 
-	virtual void FlushNetDormancy(AActor* Actor, bool WasDormInitial) override {}
+	virtual void FlushNetDormancy(AActor* Actor, bool WasDormInitial) override;
 
 	virtual void NotifyActorTearOff(AActor* Actor) override {}
 
 	virtual void NotifyActorFullyDormantForConnection(AActor* Actor, UNetConnection* Connection) override {}
 
-	virtual void NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState) override {}
+	virtual void NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState) override;
 
 	/** Called when a destruction info is created for an actor. Can be used to override some of the destruction info struct */
 	virtual void NotifyDestructionInfoCreated(AActor* Actor, FActorDestructionInfo& DestructionInfo) override {}
@@ -97,6 +97,18 @@ protected:
 
 	bool IsAllowedToReplicate(const AActor* Actor) const;
 
+	/** Resolves replication options of the class, the result is cached until the rules cache is invalidated */
+	const FHScaleClassReplicationInfo& GetClassReplicationInfo(UClass* Class) const;
+
+public:
+	/** Must be called when level roles change, the replication rules depend on them */
+	void InvalidateReplicationRulesCache() { ClassReplicationInfoCache.Reset(); }
+
+protected:
+
+	/** Moves actor back to active replication list, e.g. after dormancy flush */
+	void WakeUpActor(AActor* Actor);
+
 public:
 	UHScaleSchema* GetSchema() const { return Schema; }
 
@@ -124,4 +136,6 @@ private:
 	 * True, if the map was started with role WorldInitAgent
 	 */
 	TOptional<bool> bIsWorldInitAgent;
+
+	mutable TMap<TWeakObjectPtr<UClass>, FHScaleClassReplicationInfo> ClassReplicationInfoCache;
 };
\ No newline at end of file
@@ -146,6 +146,15 @@ private:
 	TArray<FHScale_ReplicationExcludedClass> ExcludedData;
 };
 
+/** Resolved replication options of the class, they depend only on the class and level roles */
+struct FHScaleClassReplicationInfo
+{
+	/** Result of replication rule from dev settings, true if the class has no rule */
+	uint8 bAllowedByRule : 1;
+	uint8 bClassSupported : 1;
+	uint8 bDefaultObjectSupported : 1;
+};
+
 struct FHScaleRepFlags : public FReplicationFlags
 {
 	/** True, only if scheme defines authority over the object */
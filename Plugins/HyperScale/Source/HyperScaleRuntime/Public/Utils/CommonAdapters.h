@@ -1,15 +1,86 @@
 ﻿#pragma once
-#include <map>
+#include <algorithm>
+#include <vector>
 
 /**
- * Serves as a common iterator for std::map and unreal TSet with template T as the
+ * Sorted contiguous map with a std::map like interface
+ * Keys and values live in a single vector sorted by key, lookups are binary searches and iteration is linear memory access
+ * Intended for small maps that are read far more often than they are inserted into
+ */
+template<typename K, typename V>
+class THScaleFlatMap
+{
+public:
+	using value_type = std::pair<K, V>;
+	using iterator = typename std::vector<value_type>::iterator;
+	using const_iterator = typename std::vector<value_type>::const_iterator;
+
+	bool contains(const K& Key) const
+	{
+		const const_iterator It = LowerBound(Key);
+		return It != Items.cend() && It->first == Key;
+	}
+
+	iterator find(const K& Key)
+	{
+		const iterator It = LowerBound(Key);
+		return (It != Items.end() && It->first == Key) ? It : Items.end();
+	}
+
+	const_iterator find(const K& Key) const
+	{
+		const const_iterator It = LowerBound(Key);
+		return (It != Items.cend() && It->first == Key) ? It : Items.cend();
+	}
+
+	/** Returns the value for the key, default constructing it in sorted position if missing */
+	V& operator[](const K& Key)
+	{
+		iterator It = LowerBound(Key);
+		if (It == Items.end() || It->first != Key)
+		{
+			It = Items.emplace(It, Key, V());
+		}
+		return It->second;
+	}
+
+	iterator erase(const_iterator It) { return Items.erase(It); }
+
+	void clear() { Items.clear(); }
+	void reserve(const size_t Num) { Items.reserve(Num); }
+	size_t size() const { return Items.size(); }
+	bool empty() const { return Items.empty(); }
+
+	iterator begin() { return Items.begin(); }
+	iterator end() { return Items.end(); }
+	const_iterator begin() const { return Items.cbegin(); }
+	const_iterator end() const { return Items.cend(); }
+	const_iterator cbegin() const { return Items.cbegin(); }
+	const_iterator cend() const { return Items.cend(); }
+
+private:
+	iterator LowerBound(const K& Key)
+	{
+		return std::lower_bound(Items.begin(), Items.end(), Key, [](const value_type& Item, const K& Value) { return Item.first < Value; });
+	}
+
+	const_iterator LowerBound(const K& Key) const
+	{
+		return std::lower_bound(Items.cbegin(), Items.cend(), Key, [](const value_type& Item, const K& Value) { return Item.first < Value; });
+	}
+
+	std::vector<value_type> Items;
+};
+
+/**
+ * Serves as a common iterator for THScaleFlatMap and unreal TSet with template T as the
  * iterator value
  */
 template<typename T, typename K>
 class THScaleUSetSMapIterator
 {
 public:
-	THScaleUSetSMapIterator(typename std::map<T, K>::const_iterator MapIter, typename std::map<T, K>::const_iterator MapEndIter, typename TSet<T>::TConstIterator SetIter, const bool bIsSet)
+	THScaleUSetSMapIterator(typename THScaleFlatMap<T, K>::const_iterator MapIter, typename THScaleFlatMap<T, K>::const_iterator MapEndIter, typename TSet<T>::TConstIterator SetIter, const bool bIsSet)
 		: StdMapIter(MapIter), StdMapEndIter(MapEndIter), UnrealSetIter(SetIter), bIsSet(bIsSet) {}
 
 	T operator*() const
@@ -32,8 +103,8 @@ public:
 	}
 
 private:
-	typename std::map<T, K>::const_iterator StdMapIter;
-	typename std::map<T, K>::const_iterator StdMapEndIter;
+	typename THScaleFlatMap<T, K>::const_iterator StdMapIter;
+	typename THScaleFlatMap<T, K>::const_iterator StdMapEndIter;
 	typename TSet<T>::TConstIterator UnrealSetIter;
 	bool bIsSet;
 };
@@ -42,7 +113,7 @@ template<typename K, typename V>
 class THScaleStdMapPairIterator
 {
 public:
-	THScaleStdMapPairIterator(const typename std::map<K, V>::const_iterator& StdMapIter, const typename std::map<K, V>::const_iterator& StdMapEndIter)
+	THScaleStdMapPairIterator(const typename THScaleFlatMap<K, V>::const_iterator& StdMapIter, const typename THScaleFlatMap<K, V>::const_iterator& StdMapEndIter)
 		: StdMapIter(StdMapIter),
 		  StdMapEndIter(StdMapEndIter) {}
 
@@ -56,7 +127,7 @@ public:
 		return StdMapIter->second;
 	}
 
-	typename std::map<K, V>::const_iterator Pair() const
+	typename THScaleFlatMap<K, V>::const_iterator Pair() const
 	{
 		return StdMapIter;
 	}
@@ -73,6 +144,6 @@ public:
 	}
 
 private:
-	typename std::map<K, V>::const_iterator StdMapIter;
-	const typename std::map<K, V>::const_iterator StdMapEndIter;
+	typename THScaleFlatMap<K, V>::const_iterator StdMapIter;
+	const typename THScaleFlatMap<K, V>::const_iterator StdMapEndIter;
 };
\ No newline at end of file
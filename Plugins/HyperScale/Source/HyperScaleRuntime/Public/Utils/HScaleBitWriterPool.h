@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/BitWriter.h"
+
+/**
+ * Per thread pool of pre-sized bit writers
+ * Writers are reset on release and handed out again, so large scratch buffers are allocated only once per size
+ */
+class HYPERSCALERUNTIME_API FHScaleBitWriterPool
+{
+public:
+	static FHScaleBitWriterPool& Get();
+
+	TUniquePtr<FBitWriter> Acquire(const int64 MaxBits);
+	void Release(TUniquePtr<FBitWriter>&& Writer);
+
+private:
+	// writers can be acquired recursively (entity -> components), so a few are kept per size
+	static constexpr int32 MaxPooledWritersPerSize = 8;
+
+	TMap<int64, TArray<TUniquePtr<FBitWriter>>> FreeWriters;
+};
+
+/**
+ * Scoped writer taken from FHScaleBitWriterPool, returned to the pool when it goes out of scope
+ */
+class FHScaleScopedBitWriter
+{
+public:
+	explicit FHScaleScopedBitWriter(const int64 MaxBits)
+		: Writer(FHScaleBitWriterPool::Get().Acquire(MaxBits)) {}
+
+	~FHScaleScopedBitWriter()
+	{
+		FHScaleBitWriterPool::Get().Release(MoveTemp(Writer));
+	}
+
+	FHScaleScopedBitWriter(const FHScaleScopedBitWriter&) = delete;
+	FHScaleScopedBitWriter& operator=(const FHScaleScopedBitWriter&) = delete;
+
+	FBitWriter& operator*() const { return *Writer; }
+	FBitWriter* operator->() const { return Writer.Get(); }
+
+private:
+	TUniquePtr<FBitWriter> Writer;
+};
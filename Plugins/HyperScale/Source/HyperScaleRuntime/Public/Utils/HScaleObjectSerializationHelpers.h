@@ -16,7 +16,11 @@ struct FHScaleOuterChunk
 class FHScaleObjectSerializationHelper
 {
 public:
-	static void LoadObject(UObject*& Object, TArray<FHScaleOuterChunk>& Chunks, FNetworkGUID& NetGUID, UHScalePackageMap* PkgMap);
+	/**
+	 * Finds the object described by outer chunks, objects are never loaded here
+	 * @param OutMissingPackage - if set, receives name of the outermost package when it is not loaded
+	 */
+	static void LoadObject(UObject*& Object, TArray<FHScaleOuterChunk>& Chunks, FNetworkGUID& NetGUID, UHScalePackageMap* PkgMap, FString* OutMissingPackage = nullptr);
 
 	static void ReadOuterChunkFromBunch(FBitReader& Ar, TArray<FHScaleOuterChunk>& OuterChunks, UHScalePackageMap* PackageMap);
 };
@@ -2,6 +2,7 @@
 
 #include "Engine/ActorChannel.h"
 #include "NetworkLayer/HScaleConnection.h"
+#include "NetworkLayer/HScaleMockConnection.h"
 #include "NetworkLayer/HScaleNetDriver.h"
 #include "ReplicationLayer/HScaleActorChannel.h"
 
@@ -76,6 +77,23 @@ UNetDriver* FHSTUtil::CreateUnitNetDriver(UWorld* World)
 	return HyperScaleDriver;
 }
 
+UNetDriver* FHSTUtil::CreateMockNetDriver(UWorld* World)
+{
+	UNetDriver* NetDriver = CreateUnitNetDriver(World);
+	NetDriver->NetConnectionClassName = UHScaleMockConnection::StaticClass()->GetPathName();
+	NetDriver->NetConnectionClass = UHScaleMockConnection::StaticClass();
+
+	FString Error;
+	const FURL URL(nullptr, TEXT("127.0.0.1:5000"), TRAVEL_Absolute);
+	if (!NetDriver->InitBase(false, World, URL, false, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mock net driver initialization failed: %s"), *Error);
+		return nullptr;
+	}
+
+	return NetDriver;
+}
+
 UNetConnection* FHSTUtil::CreateUnitNetConnection(UNetDriver* NetDriver)
 {
 	UHScaleConnection* Connection = NewObject<UHScaleConnection>(UHScaleConnection::StaticClass());
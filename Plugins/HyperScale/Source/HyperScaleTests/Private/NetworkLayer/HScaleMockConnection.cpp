@@ -0,0 +1,13 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+
+#include "NetworkLayer/HScaleMockConnection.h"
+
+#include "NetworkLayer/HScaleMockSession.h"
+
+TUniquePtr<IHScaleNetworkSession> UHScaleMockConnection::CreateNetworkSession()
+{
+	TUniquePtr<FHScaleMockSession> NewSession = MakeUnique<FHScaleMockSession>();
+	MockSession = NewSession.Get();
+	return NewSession;
+}
@@ -0,0 +1,108 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+
+#include "NetworkLayer/HScaleMockSession.h"
+
+#include "Events/HScaleEventsDriver.h"
+#include "MemoryLayer/HScaleNetworkBibliothec.h"
+#include "NetworkLayer/HScaleUpdates.h"
+
+bool FHScaleMockSession::Send(const FHScaleLocalUpdate& Update)
+{
+	NumSentAttributes += Update.Attributes.Num();
+
+	if (!bLoopback || Update.bIsPlayer) return true;
+
+	const quark_timestamp_t UpdateTimestamp = NextTimestamp();
+	for (const FHScaleAttributesUpdate& Atb : Update.Attributes)
+	{
+		PendingUpdates.Emplace(false, Update.ObjectId, Atb.AttributeId, Atb.Value, UpdateTimestamp);
+	}
+	return true;
+}
+
+bool FHScaleMockSession::SendEvent(const quark_event_class_t EventClass, const quark::recipient& Recipient, const uint8* Data, const size_t Size, const quark::qos Qos)
+{
+	if (Size > QUARK_MAX_PAYLOAD_LEN)
+	{
+		UE_LOG(Log_HyperScaleEvents, Error, TEXT("Mock session event %d exceeds max payload size (%llu bytes)"), EventClass, static_cast<uint64>(Size));
+		return false;
+	}
+
+	++NumSentEvents;
+	NumSentEventBytes += Size;
+	if (Qos == quark::qos::unreliable)
+	{
+		++NumSentUnreliableEvents;
+	}
+	return true;
+}
+
+bool FHScaleMockSession::Subscribe(const quark::query& Query, const quark::qos Qos)
+{
+	++NumSubscriptions;
+	return true;
+}
+
+void FHScaleMockSession::Receive(FHScaleNetworkBibliothec& Bibliothec, FHScaleEventsDriver& EventsDriver)
+{
+	// handlers are allowed to send again, so dispatch from local copies and leave new ones for next receive
+	const TArray<FHScaleMockRemoteUpdate> Updates = MoveTemp(PendingUpdates);
+	const TArray<FHScaleMockRemoteEvent> Events = MoveTemp(PendingEvents);
+	PendingUpdates.Reset();
+	PendingEvents.Reset();
+
+	for (const FHScaleMockRemoteUpdate& Update : Updates)
+	{
+		if (Update.bIsPlayer)
+		{
+			Bibliothec.HandlePlayersNetworkUpdate(Update.EntityId, Update.AttributeId, Update.Value, Update.Timestamp);
+		}
+		else
+		{
+			Bibliothec.HandleObjectsNetworkUpdate(Update.EntityId, Update.AttributeId, Update.Value, Update.Timestamp);
+		}
+	}
+	NumReceivedUpdates += Updates.Num();
+
+	for (const FHScaleMockRemoteEvent& MockEvent : Events)
+	{
+		FHScaleRemoteEvent Event;
+		Event.EventClass = MockEvent.EventClass;
+		Event.Data = MockEvent.Data.GetData();
+		Event.Size = MockEvent.Data.Num();
+		Event.bFromPlayer = MockEvent.bFromPlayer;
+		EventsDriver.HandleEvents(Event);
+	}
+	NumReceivedEvents += Events.Num();
+}
+
+void FHScaleMockSession::QueueObjectUpdate(const quark_object_id_t RemoteObjectId, const quark_attribute_id_t AttributeId, const quark::value& Value)
+{
+	PendingUpdates.Emplace(false, RemoteObjectId, AttributeId, Value, NextTimestamp());
+}
+
+void FHScaleMockSession::QueuePlayerUpdate(const quark_player_id_t RemotePlayerId, const quark_attribute_id_t AttributeId, const quark::value& Value)
+{
+	PendingUpdates.Emplace(true, RemotePlayerId, AttributeId, Value, NextTimestamp());
+}
+
+void FHScaleMockSession::QueueEvent(const quark_event_class_t EventClass, const uint8* Data, const size_t Size, const bool bFromPlayer)
+{
+	check(Size <= QUARK_MAX_PAYLOAD_LEN);
+
+	FHScaleMockRemoteEvent& Event = PendingEvents.AddDefaulted_GetRef();
+	Event.EventClass = EventClass;
+	Event.Data.Append(Data, Size);
+	Event.bFromPlayer = bFromPlayer;
+}
+
+void FHScaleMockSession::ResetCounters()
+{
+	NumSentAttributes = 0;
+	NumSentEvents = 0;
+	NumSentUnreliableEvents = 0;
+	NumSentEventBytes = 0;
+	NumReceivedUpdates = 0;
+	NumReceivedEvents = 0;
+}
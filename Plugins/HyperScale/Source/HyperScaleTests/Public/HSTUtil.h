@@ -7,6 +7,8 @@ public:
 	static UWorld* CreateUnitTestWorld();
 
 	static UNetDriver* CreateUnitNetDriver(UWorld* World);
+	/** Creates and initializes net driver with connection running on in-process mock session */
+	static UNetDriver* CreateMockNetDriver(UWorld* World);
 	static UNetConnection* CreateUnitNetConnection(UNetDriver* Driver);
 	static UActorChannel* CreateUnitActorChannelForActor(AActor* Actor, TObjectPtr<UNetConnection> NetConnection);
 	static FNetworkGUID CreateUnitNetGuid(uint64 ObjectId);
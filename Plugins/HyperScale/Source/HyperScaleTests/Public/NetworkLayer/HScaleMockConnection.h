@@ -0,0 +1,27 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkLayer/HScaleConnection.h"
+#include "HScaleMockConnection.generated.h"
+
+class FHScaleMockSession;
+
+/**
+ * Connection running on in-process FHScaleMockSession instead of hyperscale server
+ */
+UCLASS(Transient)
+class HYPERSCALETESTS_API UHScaleMockConnection : public UHScaleConnection
+{
+	GENERATED_BODY()
+
+public:
+	virtual TUniquePtr<IHScaleNetworkSession> CreateNetworkSession() override;
+
+	/** Returns the mock session owned by this connection, valid after InitHyperScaleConnection() */
+	FHScaleMockSession* GetMockSession() const { return MockSession; }
+
+private:
+	FHScaleMockSession* MockSession = nullptr;
+};
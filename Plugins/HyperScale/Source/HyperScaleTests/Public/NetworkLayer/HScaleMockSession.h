@@ -0,0 +1,86 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkLayer/HScaleNetworkSession.h"
+
+struct FHScaleMockRemoteUpdate
+{
+	FHScaleMockRemoteUpdate(const bool bInIsPlayer, const uint64 InEntityId, const quark_attribute_id_t InAttributeId, const quark::value& InValue, const quark_timestamp_t InTimestamp)
+		: bIsPlayer(bInIsPlayer)
+		, EntityId(InEntityId)
+		, AttributeId(InAttributeId)
+		, Value(InValue)
+		, Timestamp(InTimestamp) {}
+
+	bool bIsPlayer;
+	uint64 EntityId;
+	quark_attribute_id_t AttributeId;
+	quark::value Value;
+	quark_timestamp_t Timestamp;
+};
+
+struct FHScaleMockRemoteEvent
+{
+	quark_event_class_t EventClass = 0;
+	TArray<uint8> Data;
+	bool bFromPlayer = false;
+};
+
+/**
+ * In-process network session without hyperscale server
+ *
+ * Sent object attributes are looped back and received on the next Receive() call, like they would
+ * come from the server. Local player attributes are not looped back, the server never sends them to its owner.
+ * Events are only recorded, their recipients are resolved by the server so they can be injected with QueueEvent()
+ */
+class HYPERSCALETESTS_API FHScaleMockSession : public IHScaleNetworkSession
+{
+public:
+	explicit FHScaleMockSession(const quark_session_id_t InSessionId = 1, const bool bInLoopback = true)
+		: SessionId(InSessionId)
+		, bLoopback(bInLoopback) {}
+
+	// ~Begin of IHScaleNetworkSession interface
+	virtual bool Send(const FHScaleLocalUpdate& Update) override;
+	virtual bool SendEvent(const quark_event_class_t EventClass, const quark::recipient& Recipient, const uint8* Data, const size_t Size, const quark::qos Qos) override;
+	virtual bool Subscribe(const quark::query& Query, const quark::qos Qos) override;
+	virtual void Receive(FHScaleNetworkBibliothec& Bibliothec, FHScaleEventsDriver& EventsDriver) override;
+	virtual quark_session_id_t GetId() const override { return SessionId; }
+	// ~End of IHScaleNetworkSession interface
+
+	/** Simulates attribute update of remote object, received on the next Receive() call */
+	void QueueObjectUpdate(const quark_object_id_t RemoteObjectId, const quark_attribute_id_t AttributeId, const quark::value& Value);
+
+	/** Simulates attribute update of remote player, received on the next Receive() call */
+	void QueuePlayerUpdate(const quark_player_id_t RemotePlayerId, const quark_attribute_id_t AttributeId, const quark::value& Value);
+
+	/** Simulates event sent by other session, received on the next Receive() call */
+	void QueueEvent(const quark_event_class_t EventClass, const uint8* Data, const size_t Size, const bool bFromPlayer = true);
+
+	int32 NumPendingUpdates() const { return PendingUpdates.Num(); }
+	int32 NumPendingEvents() const { return PendingEvents.Num(); }
+
+	void ResetCounters();
+
+public:
+	uint64 NumSentAttributes = 0;
+	uint64 NumSentEvents = 0;
+	uint64 NumSentUnreliableEvents = 0;
+	uint64 NumSentEventBytes = 0;
+	uint64 NumReceivedUpdates = 0;
+	uint64 NumReceivedEvents = 0;
+	uint32 NumSubscriptions = 0;
+
+private:
+	/** Timestamps are just increasing counter to keep runs deterministic */
+	quark_timestamp_t NextTimestamp() { return ++Timestamp; }
+
+	TArray<FHScaleMockRemoteUpdate> PendingUpdates;
+	TArray<FHScaleMockRemoteEvent> PendingEvents;
+
+	quark_session_id_t SessionId;
+	quark_timestamp_t Timestamp = 0;
+	bool bLoopback;
+};
@@ -0,0 +1,72 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+#include "CoreMinimal.h"
+#include "MemoryLayer/HScaleMemoryTypes.h"
+#include "MemoryLayer/HScalePropertyIdConverters.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HScaleSplitPropertyTest
+{
+	void Transfer(const TArray<FHScaleAttributesUpdate>& Attributes, HScaleTypes::FHScaleSplitStringProperty& Receiver, uint64& Timestamp)
+	{
+		for (const FHScaleAttributesUpdate& Update : Attributes)
+		{
+			Receiver.Deserialize(Update.Value, Update.AttributeId, ++Timestamp);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplitStringPropertyTest, "HyperScale.MemoryLayer.Properties.SplitString",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSplitStringPropertyTest::RunTest(const FString& Parameters)
+{
+	using namespace HScaleSplitPropertyTest;
+
+	const uint16 PropertyId = FHScalePropertyIdConverters::GetAppPropertyIdFromHandle(5);
+	HScaleTypes::FHScaleSplitStringProperty Sender(HS_SPLIT_PROPERTY_MAX_LENGTH);
+	HScaleTypes::FHScaleSplitStringProperty Receiver(HS_SPLIT_PROPERTY_MAX_LENGTH);
+	uint64 Timestamp = 0;
+
+	// 100 characters are split into 4 chunks of 31 characters and continuation indicator
+	const FString Initial = FString::ChrN(100, TEXT('a'));
+	Sender.SetFullString(Initial);
+
+	TArray<FHScaleAttributesUpdate> Attributes;
+	Sender.Serialize(Attributes, PropertyId);
+	TestEqual(TEXT("All chunks are sent"), Attributes.Num(), 4);
+
+	Transfer(Attributes, Receiver, Timestamp);
+	TestTrue(TEXT("Receiver is complete"), Receiver.IsCompleteForReceive());
+	TestEqual(TEXT("Received string"), Receiver.GetValue(), Initial);
+
+	// change of the last character still sends the whole chain, chunks carry no version of the write
+	const FString Changed = FString::ChrN(99, TEXT('a')) + TEXT("b");
+	Sender.SetFullString(Changed);
+
+	Attributes.Reset();
+	Sender.Serialize(Attributes, PropertyId);
+	TestEqual(TEXT("All chunks are sent after change"), Attributes.Num(), 4);
+
+	Transfer(Attributes, Receiver, Timestamp);
+	TestEqual(TEXT("Received string after change"), Receiver.GetValue(), Changed);
+
+	// shortening moves end indicator into second chunk
+	const FString Shortened = FString::ChrN(40, TEXT('b'));
+	Sender.SetFullString(Shortened);
+
+	Attributes.Reset();
+	Sender.Serialize(Attributes, PropertyId);
+	TestEqual(TEXT("Shortened chain is sent"), Attributes.Num(), 2);
+
+	// chunks of previous write are forgotten, so the first new chunk alone does not complete the string
+	Receiver.Deserialize(Attributes[1].Value, Attributes[1].AttributeId, ++Timestamp);
+	TestFalse(TEXT("Receiver waits for the rest of new write"), Receiver.IsCompleteForReceive());
+	Receiver.Deserialize(Attributes[0].Value, Attributes[0].AttributeId, ++Timestamp);
+	TestEqual(TEXT("Received string after shortening"), Receiver.GetValue(), Shortened);
+	TestEqual(TEXT("Receiver chunk count"), static_cast<int32>(Receiver.NumProps()), 2);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
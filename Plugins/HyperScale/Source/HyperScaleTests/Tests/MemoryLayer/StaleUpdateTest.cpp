@@ -0,0 +1,71 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+#include "CoreMinimal.h"
+#include "MemoryLayer/HScaleNetworkBibliothec.h"
+#include "MemoryLayer/HScaleMemoryTypes.h"
+#include "MemoryLayer/HScaleNetworkEntity.h"
+#include "MemoryLayer/HScalePropertyIdConverters.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaleUpdateTest, "HyperScale.MemoryLayer.NetworkEntity.StaleUpdate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FStaleUpdateTest::RunTest(const FString& Parameters)
+{
+	constexpr quark_object_id_t RemoteObjectId = 1000000;
+	const uint16 PropertyId = FHScalePropertyIdConverters::GetAppPropertyIdFromHandle(1);
+
+	FHScaleNetworkBibliothec Bibliothec;
+	Bibliothec.CreateLocalPlayerEntity(1);
+
+	Bibliothec.HandleObjectsNetworkUpdate(RemoteObjectId, PropertyId, quark::value(2.f), 10);
+	Bibliothec.ClearServerDirtyEntities();
+
+	// update sent before the applied one arrives late
+	Bibliothec.HandleObjectsNetworkUpdate(RemoteObjectId, PropertyId, quark::value(1.f), 5);
+	TestEqual(TEXT("Stale update is counted"), Bibliothec.NumDroppedStaleUpdates(), static_cast<uint64>(1));
+	TestEqual(TEXT("Stale update does not dirty the entity"), Bibliothec.NumServerDirtyEntities(), static_cast<uint64>(0));
+
+	const TSharedPtr<FHScaleNetworkEntity> Entity = Bibliothec.FindExistingEntity(FHScaleNetGUID::Create_Object(RemoteObjectId));
+	if (!TestTrue(TEXT("Entity exists"), Entity.IsValid())) { return false; }
+	TestEqual(TEXT("Entity counts stale update"), Entity->NumDroppedStaleUpdates(), static_cast<uint32>(1));
+
+	const HScaleTypes::FHScaleFloatProperty* Property = static_cast<const HScaleTypes::FHScaleFloatProperty*>(Entity->FindExistingProperty(PropertyId));
+	if (!TestNotNull(TEXT("Property exists"), Property)) { return false; }
+	TestEqual(TEXT("Value of newer update is kept"), Property->GetValue(), 2.f);
+
+	// update with same timestamp belongs to the same server update and is applied
+	Bibliothec.HandleObjectsNetworkUpdate(RemoteObjectId, PropertyId, quark::value(3.f), 10);
+	TestEqual(TEXT("Update with same timestamp is applied"), Property->GetValue(), 3.f);
+	TestEqual(TEXT("No new stale updates"), Bibliothec.NumDroppedStaleUpdates(), static_cast<uint64>(1));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaleSplitChunkTest, "HyperScale.MemoryLayer.Properties.StaleSplitChunk",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FStaleSplitChunkTest::RunTest(const FString& Parameters)
+{
+	const uint16 PropertyId = FHScalePropertyIdConverters::GetAppPropertyIdFromHandle(5);
+	HScaleTypes::FHScaleSplitStringProperty Sender(HS_SPLIT_PROPERTY_MAX_LENGTH);
+	HScaleTypes::FHScaleSplitStringProperty Receiver(HS_SPLIT_PROPERTY_MAX_LENGTH);
+
+	const FString Value = FString::ChrN(40, TEXT('a'));
+	Sender.SetFullString(Value);
+
+	TArray<FHScaleAttributesUpdate> Attributes;
+	Sender.Serialize(Attributes, PropertyId);
+	if (!TestEqual(TEXT("Two chunks are sent"), Attributes.Num(), 2)) { return false; }
+
+	// chunks are separate attributes, the second one can be stamped by server before the first one
+	TestTrue(TEXT("Later chunk is applied"), Receiver.Deserialize(Attributes[1].Value, Attributes[1].AttributeId, 10));
+	TestTrue(TEXT("Chunk with older timestamp of another index is applied"), Receiver.Deserialize(Attributes[0].Value, Attributes[0].AttributeId, 5));
+	TestEqual(TEXT("Received string"), Receiver.GetValue(), Value);
+
+	TestFalse(TEXT("Older update of the same chunk is dropped"), Receiver.Deserialize(Attributes[0].Value, Attributes[0].AttributeId, 4));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
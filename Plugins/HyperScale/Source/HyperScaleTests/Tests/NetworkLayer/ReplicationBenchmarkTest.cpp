@@ -0,0 +1,175 @@
+// Copyright 2024 Metagravity. All Rights Reserved.
+#include "CoreMinimal.h"
+#include "HSTUtil.h"
+#include "Actors/TestHScaleCharacter.h"
+#include "Events/HScaleEventsDriver.h"
+#include "MemoryLayer/HScaleNetworkBibliothec.h"
+#include "MemoryLayer/HScalePropertyIdConverters.h"
+#include "NetworkLayer/HScaleMockConnection.h"
+#include "NetworkLayer/HScaleMockSession.h"
+#include "NetworkLayer/HScaleNetDriver.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HScaleReplicationBenchmark
+{
+	constexpr int32 NumEntities = 1000;
+	constexpr int32 NumTicks = 120;
+	constexpr float TickDeltaSeconds = 1.f / 30.f;
+
+	// remote object ids are far from ids assigned to the local session
+	constexpr quark_object_id_t FirstRemoteObjectId = 1000000;
+
+	struct FTickStats
+	{
+		int32 NumTicks = 0;
+		double TotalSeconds = 0.0;
+		double MinSeconds = TNumericLimits<double>::Max();
+		double MaxSeconds = 0.0;
+
+		void AddTick(const double Seconds)
+		{
+			++NumTicks;
+			TotalSeconds += Seconds;
+			MinSeconds = FMath::Min(MinSeconds, Seconds);
+			MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+		}
+	};
+
+	/** Queues one tick worth of remote changes, position and one application property per entity */
+	void QueueRemoteEntityUpdates(FHScaleMockSession& Session, const int32 Tick)
+	{
+		const uint16 ValueAttributeId = FHScalePropertyIdConverters::GetAppPropertyIdFromHandle(1);
+		for (int32 i = 0; i < NumEntities; ++i)
+		{
+			const quark_object_id_t RemoteObjectId = FirstRemoteObjectId + i;
+			const quark::vec3 Position{static_cast<float>(i * 100), static_cast<float>(Tick), 0.f};
+			Session.QueueObjectUpdate(RemoteObjectId, QUARK_KNOWN_ATTRIBUTE_POSITION, quark::value(Position));
+			Session.QueueObjectUpdate(RemoteObjectId, ValueAttributeId, quark::value(static_cast<float>(Tick)));
+		}
+	}
+
+	/** Memory growth is sampled from platform stats, it is an approximation of allocations made by the benchmark */
+	void Report(FAutomationTestBase& Test, const FString& Name, const FTickStats& Stats, const uint64 NumItems, const FPlatformMemoryStats& MemoryBefore, const FPlatformMemoryStats& MemoryAfter)
+	{
+		const double MeanMs = Stats.NumTicks > 0 ? Stats.TotalSeconds / Stats.NumTicks * 1000.0 : 0.0;
+		const double Throughput = Stats.TotalSeconds > 0.0 ? NumItems / Stats.TotalSeconds : 0.0;
+		const int64 PhysicalDelta = static_cast<int64>(MemoryAfter.UsedPhysical) - static_cast<int64>(MemoryBefore.UsedPhysical);
+		const int64 VirtualDelta = static_cast<int64>(MemoryAfter.UsedVirtual) - static_cast<int64>(MemoryBefore.UsedVirtual);
+
+		Test.AddInfo(FString::Printf(TEXT("%s: %d ticks, tick mean %.3f ms, min %.3f ms, max %.3f ms"),
+			*Name, Stats.NumTicks, MeanMs, Stats.MinSeconds * 1000.0, Stats.MaxSeconds * 1000.0));
+		Test.AddInfo(FString::Printf(TEXT("%s: %llu updates, %.0f updates/s"), *Name, NumItems, Throughput));
+		Test.AddInfo(FString::Printf(TEXT("%s: memory growth physical %lld KB, virtual %lld KB"), *Name, PhysicalDelta / 1024, VirtualDelta / 1024));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBibliothecReceiveBenchmark, "HyperScale.Benchmarks.Replication.BibliothecReceive",
+	EAutomationTestFlags::Type(EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter))
+
+bool FBibliothecReceiveBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace HScaleReplicationBenchmark;
+
+	FHScaleMockSession Session;
+	FHScaleEventsDriver EventsDriver(nullptr);
+	FHScaleNetworkBibliothec Bibliothec;
+	Bibliothec.CreateLocalPlayerEntity(Session.GetId());
+
+	// first tick creates all entities, it is not part of the measurement
+	QueueRemoteEntityUpdates(Session, 0);
+	Session.Receive(Bibliothec, EventsDriver);
+	Bibliothec.ClearServerDirtyEntities();
+	Session.ResetCounters();
+
+	// bibliothec runs without net driver here, so only the receive side is measured
+	FTickStats Stats;
+	const FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+	for (int32 Tick = 1; Tick <= NumTicks; ++Tick)
+	{
+		QueueRemoteEntityUpdates(Session, Tick);
+
+		const double StartTime = FPlatformTime::Seconds();
+		Session.Receive(Bibliothec, EventsDriver);
+		Bibliothec.ClearServerDirtyEntities();
+		Stats.AddTick(FPlatformTime::Seconds() - StartTime);
+	}
+	const FPlatformMemoryStats MemoryAfter = FPlatformMemory::GetStats();
+
+	TestEqual(TEXT("All queued updates were received"), Session.NumReceivedUpdates, static_cast<uint64>(NumTicks) * NumEntities * 2);
+	TestEqual(TEXT("Server dirty entities are cleared"), Bibliothec.NumServerDirtyEntities(), static_cast<uint64>(0));
+
+	Report(*this, TEXT("BibliothecReceive"), Stats, Session.NumReceivedUpdates, MemoryBefore, MemoryAfter);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConnectionTickBenchmark, "HyperScale.Benchmarks.Replication.ConnectionTick",
+	EAutomationTestFlags::Type(EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter))
+
+bool FConnectionTickBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace HScaleReplicationBenchmark;
+
+	UWorld* UnitTestWorld = FHSTUtil::CreateUnitTestWorld();
+	UHScaleNetDriver* Driver = Cast<UHScaleNetDriver>(FHSTUtil::CreateMockNetDriver(UnitTestWorld));
+	if (!TestNotNull(TEXT("Mock net driver initialized"), Driver)) { return false; }
+
+	UHScaleMockConnection* Connection = Cast<UHScaleMockConnection>(Driver->GetHyperScaleConnection());
+	if (!TestNotNull(TEXT("Mock connection created"), Connection)) { return false; }
+
+	FHScaleMockSession* Session = Connection->GetMockSession();
+	if (!TestNotNull(TEXT("Mock session created"), Session)) { return false; }
+
+	// local actors go out through actor channels, loop back from the mock session and come back through the memory layer
+	TArray<ATestHScaleCharacter*> LocalActors;
+	LocalActors.Reserve(NumEntities);
+	for (int32 i = 0; i < NumEntities; ++i)
+	{
+		ATestHScaleCharacter* Actor = UnitTestWorld->SpawnActor<ATestHScaleCharacter>(FVector(i * 100.f, 0.f, 0.f), FRotator::ZeroRotator);
+		if (Actor) { LocalActors.Add(Actor); }
+	}
+	TestEqual(TEXT("All local actors spawned"), LocalActors.Num(), NumEntities);
+
+	Session->ResetCounters();
+
+	FTickStats Stats;
+	int32 NumTicksWithSentAttributes = 0;
+	const FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+	for (int32 Tick = 1; Tick <= NumTicks; ++Tick)
+	{
+		// unit world is never ticked, time is moved forward so actors become due by their NetUpdateFrequency again
+		UnitTestWorld->TimeSeconds += TickDeltaSeconds;
+
+		for (ATestHScaleCharacter* Actor : LocalActors)
+		{
+			Actor->ReplicatedValue1 = Tick;
+			Actor->SetActorLocation(Actor->GetActorLocation() + FVector(0.f, 1.f, 0.f));
+		}
+		QueueRemoteEntityUpdates(*Session, Tick);
+
+		const uint64 NumSentAttributesBefore = Session->NumSentAttributes;
+		const double StartTime = FPlatformTime::Seconds();
+		// TickFlush ticks the hyperscale connection, so pull, send and receive run once per measured tick
+		Driver->TickFlush(TickDeltaSeconds);
+		Stats.AddTick(FPlatformTime::Seconds() - StartTime);
+
+		if (Session->NumSentAttributes > NumSentAttributesBefore) { ++NumTicksWithSentAttributes; }
+	}
+	const FPlatformMemoryStats MemoryAfter = FPlatformMemory::GetStats();
+
+	TestEqual(TEXT("Local changes were sent on every tick"), NumTicksWithSentAttributes, NumTicks);
+	TestTrue(TEXT("Remote changes were received"), Session->NumReceivedUpdates > 0);
+
+	Report(*this, TEXT("ConnectionTick"), Stats, Session->NumSentAttributes + Session->NumReceivedUpdates, MemoryBefore, MemoryAfter);
+	AddInfo(FString::Printf(TEXT("ConnectionTick: sent %llu attributes, %llu events (%llu bytes), received %llu updates"),
+		Session->NumSentAttributes, Session->NumSentEvents, Session->NumSentEventBytes, Session->NumReceivedUpdates));
+
+	GEngine->DestroyNamedNetDriver(UnitTestWorld, Driver->NetDriverName);
+	GEngine->DestroyWorldContext(UnitTestWorld);
+	UnitTestWorld->DestroyWorld(false);
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS